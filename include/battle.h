@@ -313,6 +313,72 @@ struct SimulatedDamage
     u16 maximum;
 };
 
+#define AI_DAMAGE_CACHE_SIZE 64 // Must be a power of two
+#define AI_DAMAGE_CACHE_KEYS 16 // Distinct battler and field states kept per turn
+
+// Everything about a single battler that its damage calcs read, including
+// the temporary changes made by SetBattlerData and switch-in simulations.
+struct AiDamageBattlerKey
+{
+    struct BattlePokemon mon;
+    struct DisableStruct disableStruct;
+    struct ProtectStruct protectStruct; // Helping Hand
+    u32 status3; // Magnet Rise, Telekinesis, Minimize, Charged Up
+    u32 status4;
+    u64 aiFlags;
+    u16 ability;
+    u16 holdEffect;
+    u8 timesGotHit; // Rage Fist
+    u8 bonusCritStages;
+    u8 sameMoveTurns;
+    u8 stompingTantrumTimer;
+    u8 gimmick;
+    u8 usableGimmick;
+    u8 partyIndex;
+};
+
+// Field effects and abilities of every battler, since allies and auras affect damage too.
+struct AiDamageFieldKey
+{
+    u32 fieldStatuses;
+    u32 sideStatuses[NUM_BATTLE_SIDES];
+    struct SideTimer sideTimers[NUM_BATTLE_SIDES]; // Retaliate
+    u16 abilities[MAX_BATTLERS_COUNT];
+    u16 aiAbilities[MAX_BATTLERS_COUNT];
+    u8 battlersCount;
+    u8 aliveBattlers;
+};
+
+// An AI_CalcDamage result, keyed by the indexes of the battler and field states it was calculated from.
+struct AiDamageCacheEntry
+{
+    u16 move;
+    u16 weather;
+    u8 atkKey;
+    u8 defKey;
+    u8 fieldKey;
+    u8 battlerAtk:2;
+    u8 battlerDef:2;
+    u8 gimmickAtk:1;
+    u8 gimmickDef:1;
+    u8 valid:1;
+    u8 padding:1;
+    uq4_12_t effectiveness;
+    struct SimulatedDamage dmg;
+};
+
+// Keys are compared in full, the hashes only speed up finding them.
+struct AiDamageCache
+{
+    struct AiDamageCacheEntry entries[AI_DAMAGE_CACHE_SIZE];
+    struct AiDamageBattlerKey battlerKeys[AI_DAMAGE_CACHE_KEYS];
+    struct AiDamageFieldKey fieldKeys[AI_DAMAGE_CACHE_KEYS];
+    u32 battlerKeyHashes[AI_DAMAGE_CACHE_KEYS];
+    u32 fieldKeyHashes[AI_DAMAGE_CACHE_KEYS];
+    u8 battlerKeyCount;
+    u8 fieldKeyCount;
+};
+
 // Ai Data used when deciding which move to use, computed only once before each turn's start.
 struct AiLogicData
 {
@@ -342,6 +408,15 @@ struct AiLogicData
     u8 aiCalcInProgress:1;
     u8 battlerDoingPrediction; // Stores which battler is currently running its prediction calcs
     u16 predictedMove[MAX_BATTLERS_COUNT];
+    u32 simulationInputsHash; // Battle state the damage simulations were started from, they start over if it changes
+    u16 simulationWeather; // AI_GetWeather() when the turn's damage simulations were started
+    u8 simulationBattlerAtk; // Position of the next damage simulation, resumed by ContinueAiLogicDataForTurn
+    u8 simulationBattlerDef;
+    u8 simulationMoveIndex;
+    bool8 simulationsPending;
+#if AI_DAMAGE_CACHE
+    struct AiDamageCache damageCache; // Cleared along with the rest of the struct every turn, and by AI_ClearDamageCache
+#endif
 };
 
 struct AiThinkingStruct
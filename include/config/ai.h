@@ -60,6 +60,8 @@
 // AI damage calc considerations
 #define RISKY_AI_CRIT_STAGE_THRESHOLD                           2   // Stat stages at which Risky will assume it gets a crit
 #define RISKY_AI_CRIT_THRESHOLD_GEN_1                           128 // "Stat stage" at which Risky will assume it gets a crit with gen 1 mechanics (this translates to an X / 255 % crit threshold)
+#define AI_DAMAGE_CACHE                                         TRUE // Reuses AI_CalcDamage results within a turn while both battlers and the field are unchanged, instead of recalculating them for every check
+#define AI_DAMAGE_SIMULATIONS_PER_FRAME                         16   // Number of (attacker, target, move) damage simulations done per frame at the start of a turn, restarted if the battle changes in between. The AI then scores one battler per frame before action selection starts. 0 does the simulations in one frame
 
 // AI prediction chances
 #define PREDICT_SWITCH_CHANCE                                   50
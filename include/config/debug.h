@@ -11,6 +11,10 @@
 #define DEBUG_BATTLE_MENU               TRUE    // If set to TRUE, enables a debug menu to use in battles by pressing the Select button.
 #define DEBUG_AI_DELAY_TIMER            FALSE   // If set to TRUE, displays the number of frames it takes for the AI to choose a move. Replaces the "What will PKMN do" text. Useful for devs or anyone who modifies the AI code and wants to see if it doesn't take too long to run.
 
+// Task Debug
+#define DEBUG_TASK_CYCLES               FALSE   // If set to TRUE, counts the CPU cycles spent in every task function and prints the worst offenders over mgba every DEBUG_TASK_CYCLES_FRAMES frames. Does nothing if NDEBUG is defined, and cannot be used in tests.
+#define DEBUG_TASK_CYCLES_FRAMES        60
+
 // Pokémon Debug
 #define DEBUG_POKEMON_SPRITE_VISUALIZER TRUE    // Enables a debug menu for Pokémon sprites and icons, accessed by pressing Select in the summary screen.
 
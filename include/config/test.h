@@ -1138,6 +1138,8 @@
 #define B_FLAG_SLEEP_CLAUSE              TESTING_FLAG_SLEEP_CLAUSE
 #undef B_FLAG_INVERSE_BATTLE
 #define B_FLAG_INVERSE_BATTLE            TESTING_FLAG_INVERSE_BATTLE
+#undef B_FLAG_BURST_SCRIPT_COMMANDS
+#define B_FLAG_BURST_SCRIPT_COMMANDS     TESTING_FLAG_BURST_SCRIPT_COMMANDS
 
 // Compression DebugPrintf switch
 #define T_COMPRESSION_SHOULD_PRINT FALSE
@@ -107,6 +107,16 @@ enum GroundEffect
 #define GROUND_EFFECT_FLAG_SEAWEED               (1 << GROUND_EFFECT_SEAWEED)
 #define GROUND_EFFECT_FLAG_SNOW                  (1 << GROUND_EFFECT_SNOW)
 
+// Snapshot of which tiles in a window of the map have an active object event on them.
+#define OBJECT_EVENT_OCCUPANCY_SIZE 32
+
+struct ObjectEventOccupancy
+{
+    s16 left;
+    s16 top;
+    u32 rows[OBJECT_EVENT_OCCUPANCY_SIZE]; // Bit per column
+};
+
 struct PairedPalettes
 {
     u16 tag;
@@ -123,6 +133,8 @@ struct FollowerSpriteVisualizerData
 u8 GetObjectEventIdByLocalIdAndMap(u8, u8, u8);
 bool8 TryGetObjectEventIdByLocalIdAndMap(u8, u8, u8, u8 *);
 u8 GetObjectEventIdByXY(s16, s16);
+void BuildObjectEventOccupancy(struct ObjectEventOccupancy *occupancy, s16 left, s16 top);
+bool32 IsObjectEventOccupancySet(const struct ObjectEventOccupancy *occupancy, s16 x, s16 y);
 void SetObjectEventDirection(struct ObjectEvent *, u8);
 void RemoveObjectEventByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroup);
 u16 GetBoulderRevealFlagByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroup);
@@ -22,6 +22,8 @@
 #define MAP_OFFSET_W (MAP_OFFSET * 2 + 1)
 #define MAP_OFFSET_H (MAP_OFFSET * 2)
 
+#define IS_ENCOUNTER_METATILE(mask, metatileId) (((mask)[(metatileId) / 32] >> ((metatileId) % 32)) & 1)
+
 extern struct BackupMapLayout VMap;
 extern const struct MapLayout Route1_Layout;
 extern u16 ALIGNED(4) sBackupMapData[VIRTUAL_MAP_SIZE];
@@ -41,6 +43,7 @@ const struct MapConnection * GetMapConnectionAtPos(s16 x, s16 y);
 void ApplyGlobalTintToPaletteSlot(u8 slot, u8 count);
 void SaveMapView(void);
 u32 ExtractMetatileAttribute(u32 attributes, u8 attributeType);
+const u32 *GetEncounterMetatileMask(u32 encounterType);
 u32 MapGridGetMetatileAttributeAt(s16 x, s16 y, u8 attributeType);
 void MapGridSetMetatileImpassabilityAt(s32 x, s32 y, bool32 arg2);
 bool8 CameraMove(s32 x, s32 y);
@@ -16,7 +16,11 @@
 #define USED __attribute__((used))
 #define KEEP_SECTION __attribute__((section(".text.consts")))
 
+#if NATIVE
+#define ARM_FUNC
+#else
 #define ARM_FUNC __attribute__((target("arm")))
+#endif
 
 #if MODERN
 #define NOINLINE __attribute__((noinline))
@@ -47,6 +47,18 @@
 #define INCBIN_COMP INCBIN
 #endif // IDE support
 
+#if NATIVE
+// Host test builds don't need graphics or other binary data.
+#define INCBIN(...) {0}
+#define INCBIN_U8   INCBIN
+#define INCBIN_U16  INCBIN
+#define INCBIN_U32  INCBIN
+#define INCBIN_S8   INCBIN
+#define INCBIN_S16  INCBIN
+#define INCBIN_S32  INCBIN
+#define INCBIN_COMP INCBIN
+#endif // NATIVE
+
 #define ARRAY_COUNT(array) (sizeof(array) / sizeof((array)[0]))
 
 // Alias of ARRAY_COUNT using GameFreak's name from AgbAssert calls.
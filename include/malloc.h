@@ -66,4 +66,16 @@ void InitHeap(void *pointer, u32 size);
 const struct MemBlock *HeapHead(void);
 const char *MemBlockLocation(const struct MemBlock *block);
 
+#if TESTING
+// Collected since the last InitHeap. peakUsed includes the block headers.
+struct HeapStats
+{
+    u32 peakUsed;
+    u32 minLargestFree; // Smallest the largest free block has been.
+    u32 maxFragmentation; // Most free memory outside the largest free block, in percent.
+};
+
+const struct HeapStats *GetHeapStats(void);
+#endif
+
 #endif // GUARD_MALLOC_H
@@ -284,6 +284,18 @@ struct Pokemon
     u16 spDefense;
 };
 
+// A decrypted box mon, see OpenBoxMonView.
+struct BoxMonView
+{
+    struct BoxPokemon *boxMon;
+    struct PokemonSubstruct0 *substruct0;
+    struct PokemonSubstruct1 *substruct1;
+    struct PokemonSubstruct2 *substruct2;
+    struct PokemonSubstruct3 *substruct3;
+    bool8 isValid; // Checksum matched, otherwise the mon was turned into a Bad Egg and can't be modified
+    bool8 modified;
+};
+
 struct MonSpritesGfxManager
 {
     u32 numSprites:4;
@@ -536,7 +548,7 @@ struct SpeciesInfo /*0xC4*/
     u16 padding5:12;
     // Move Data
     const struct LevelUpMove *levelUpLearnset;
-    const u16 *teachableLearnset;
+    const struct TeachableLearnset *teachableLearnset;
     const u16 *eggMoveLearnset;
     const struct Evolution *evolutions;
     const u16 *formSpeciesIdTable;
@@ -731,6 +743,7 @@ void CalculateMonStats(struct Pokemon *mon);
 void BoxMonToMon(const struct BoxPokemon *src, struct Pokemon *dest);
 u8 GetLevelFromMonExp(struct Pokemon *mon);
 u8 GetLevelFromBoxMonExp(struct BoxPokemon *boxMon);
+u8 GetLevelFromBoxMonViewExp(struct BoxMonView *view);
 u16 GiveMoveToMon(struct Pokemon *mon, u16 move);
 u16 GiveMoveToBoxMon(struct BoxPokemon *boxMon, u16 move);
 u16 GiveMoveToBattleMon(struct BattlePokemon *mon, u16 move);
@@ -767,6 +780,10 @@ u32 GetBoxMonData2(struct BoxPokemon *boxMon, s32 field);
 
 void SetMonData(struct Pokemon *mon, s32 field, const void *dataArg);
 void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg);
+void OpenBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon);
+void CloseBoxMonView(struct BoxMonView *view);
+u32 GetBoxMonViewData(struct BoxMonView *view, s32 field, u8 *data);
+void SetBoxMonViewData(struct BoxMonView *view, s32 field, const void *data);
 void CopyMon(void *dest, void *src, size_t size);
 u8 GiveMonToPlayer(struct Pokemon *mon);
 u8 CopyMonToPC(struct Pokemon *mon);
@@ -845,6 +862,7 @@ u8 CheckPartyHasHadPokerus(struct Pokemon *party, u8 selection);
 void UpdatePartyPokerusTime(u16 days);
 void PartySpreadPokerus(struct Pokemon *party);
 bool8 TryIncrementMonLevel(struct Pokemon *mon);
+bool32 IsTeachableMoveUniversal(u16 move);
 u8 CanLearnTeachableMove(u16 species, u16 move);
 u8 GetMoveRelearnerMoves(struct Pokemon *mon, u16 *moves);
 u8 GetLevelUpMovesBySpecies(u16 species, u16 *moves);
@@ -270,6 +270,7 @@ u32 CreateSprite(const struct SpriteTemplate *template, s16 x, s16 y, u32 subpri
 u32 CreateSpriteAtEnd(const struct SpriteTemplate *template, s16 x, s16 y, u32 subpriority);
 u32 CreateInvisibleSprite(void (*callback)(struct Sprite *));
 u32 CreateSpriteAndAnimate(const struct SpriteTemplate *template, s16 x, s16 y, u32 subpriority);
+void CloneSpriteAt(u32 index, const struct Sprite *sprite);
 void DestroySprite(struct Sprite *sprite);
 void ResetOamRange(u32 start, u32 end);
 void LoadOam(void);
@@ -658,11 +658,29 @@ struct AILogLine
 
 // Data which is updated by the test runner during a battle and needs to
 // be reset between trials.
+#define MAX_TRACE_EVENTS 64
+
+enum TraceEventType
+{
+    TRACE_RANDOM,
+    TRACE_MESSAGE,
+};
+
+// A tagged Random* call and its result, or a message and its hash.
+struct TraceEvent
+{
+    u16 type;
+    u16 tag;
+    u32 value;
+};
+
 struct BattleTrialData
 {
     u8 lastActionTurn;
     u8 queuedEvent;
     u8 aiActionsPlayed[MAX_BATTLERS_COUNT];
+    u16 traceEventsCount; // Keeps counting past MAX_TRACE_EVENTS.
+    struct TraceEvent traceEvents[MAX_TRACE_EVENTS];
 };
 
 struct BattleTestData
@@ -761,7 +779,7 @@ extern struct BattleTestRunnerState *const gBattleTestRunnerState;
 #define BATTLE_TEST_ARGS_SINGLE(_name, _type, ...) \
     struct CAT(Result, __LINE__) { RECURSIVELY(R_FOR_EACH(APPEND_SEMICOLON, __VA_ARGS__)) }; \
     static void CAT(Test, __LINE__)(struct CAT(Result, __LINE__) *, const u32, struct BattlePokemon *, struct BattlePokemon *); \
-    __attribute__((section(".tests"), used)) static const struct Test CAT(sTest, __LINE__) = \
+    __attribute__((section(TESTS_SECTION), used)) static const struct Test CAT(sTest, __LINE__) = \
     { \
         .name = _name, \
         .filename = __FILE__, \
@@ -779,7 +797,7 @@ extern struct BattleTestRunnerState *const gBattleTestRunnerState;
 #define BATTLE_TEST_ARGS_DOUBLE(_name, _type, ...) \
     struct CAT(Result, __LINE__) { RECURSIVELY(R_FOR_EACH(APPEND_SEMICOLON, __VA_ARGS__)) }; \
     static void CAT(Test, __LINE__)(struct CAT(Result, __LINE__) *, const u32, struct BattlePokemon *, struct BattlePokemon *, struct BattlePokemon *, struct BattlePokemon *); \
-    __attribute__((section(".tests"), used)) static const struct Test CAT(sTest, __LINE__) = \
+    __attribute__((section(TESTS_SECTION), used)) static const struct Test CAT(sTest, __LINE__) = \
     { \
         .name = _name, \
         .filename = __FILE__, \
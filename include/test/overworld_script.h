@@ -26,6 +26,14 @@
 #include "script.h"
 #include "test/test.h"
 
+#if NATIVE
+// The script macros are ARM assembly, so scripts only run in mgba.
+#define OVERWORLD_SCRIPT(...) \
+    ({ \
+        Test_ExitWithResult(TEST_RESULT_ASSUMPTION_FAIL, SourceLine(0), ":L%s:%d: OVERWORLD_SCRIPT needs mgba-rom-test", gTestRunnerState.test->filename, SourceLine(0)); \
+        (const u8 *)NULL; \
+    })
+#else
 #define OVERWORLD_SCRIPT(...) \
     ({ \
         const u8 *_script; \
@@ -39,9 +47,11 @@
         : "=r" (_script)); \
         _script; \
     })
+#endif // NATIVE
 
 #define RUN_OVERWORLD_SCRIPT(...) RunScriptImmediately(OVERWORLD_SCRIPT(__VA_ARGS__))
 
+#if !NATIVE
 // Make important constants available.
 // TODO: Find a better approach to this.
 asm(".set FALSE, 0\n"
@@ -57,5 +67,6 @@ asm(".include \"constants/gba_constants.inc\"\n");
 asm(".include \"constants/gba_constants.inc\"\n"
     ".include \"asm/macros/asm.inc\"\n"
     ".include \"asm/macros/event.inc\"\n");
+#endif // !NATIVE
 
 #endif
@@ -52,10 +52,13 @@ struct TestRunnerState
     bool8 inBenchmark:1;
     bool8 tearDown:1;
     u32 timeoutSeconds;
+    u32 timerOverflows;
 };
 
 extern const u8 gTestRunnerN;
 extern const u8 gTestRunnerI;
+extern const u32 gTestRunnerRangeStart;
+extern const u32 gTestRunnerRangeEnd;
 extern const char gTestRunnerArgv[256];
 
 extern const struct TestRunner gAssumptionsRunner;
@@ -82,9 +85,17 @@ u32 SourceLineOffset(u32 sourceLine);
 
 s32 Test_MgbaPrintf(const char *fmt, ...);
 
+// Host linkers only define __start_/__stop_ symbols for sections whose
+// names are C identifiers. ld_script_test.ld handles the GBA build.
+#if NATIVE
+#define TESTS_SECTION "tests"
+#else
+#define TESTS_SECTION ".tests"
+#endif
+
 #define TEST(_name) \
     static void CAT(Test, __LINE__)(void); \
-    __attribute__((section(".tests"), used)) static const struct Test CAT(sTest, __LINE__) = \
+    __attribute__((section(TESTS_SECTION), used)) static const struct Test CAT(sTest, __LINE__) = \
     { \
         .name = _name, \
         .filename = __FILE__, \
@@ -96,7 +107,7 @@ s32 Test_MgbaPrintf(const char *fmt, ...);
 
 #define ASSUMPTIONS \
     static void Assumptions(void); \
-    __attribute__((section(".tests"), used, no_reorder)) static const struct Test sAssumptions = \
+    __attribute__((section(TESTS_SECTION), used, no_reorder)) static const struct Test sAssumptions = \
     { \
         .name = "ASSUMPTIONS: " __FILE__, \
         .filename = __FILE__, \
@@ -170,6 +181,13 @@ s32 Test_MgbaPrintf(const char *fmt, ...);
 
 struct Benchmark { s32 ticks; };
 
+#if NATIVE
+// Host timings say nothing about the GBA, so benchmarks only run in mgba.
+static inline void BenchmarkStart(void)
+{
+    Test_ExitWithResult(TEST_RESULT_ASSUMPTION_FAIL, SourceLine(0), ":L%s:%d: BENCHMARK needs mgba-rom-test", gTestRunnerState.test->filename, SourceLine(0));
+}
+#else
 static inline void BenchmarkStart(void)
 {
     gTestRunnerState.inBenchmark = TRUE;
@@ -178,6 +196,7 @@ static inline void BenchmarkStart(void)
     VBlankIntrWait();
     REG_TM3CNT = (TIMER_ENABLE | TIMER_64CLK) << 16;
 }
+#endif
 
 static inline struct Benchmark BenchmarkStop(void)
 {
@@ -4,6 +4,7 @@
 extern const bool8 gTestRunnerEnabled;
 extern const bool8 gTestRunnerHeadless;
 extern const bool8 gTestRunnerSkipIsFail;
+extern const bool8 gTestRunnerProfile;
 
 #if TESTING
 
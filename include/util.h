@@ -8,6 +8,25 @@
 extern const u8 gMiscBlank_Gfx[]; // unused in Emerald
 extern const u32 gBitTable[];
 
+#define FNV1A_INITIAL_HASH 2166136261u
+
+// FNV-1a, a word at a time.
+static inline u32 HashWord(u32 hash, u32 word)
+{
+    return (hash ^ word) * 16777619;
+}
+
+// size is in bytes and is rounded down to whole words.
+static inline u32 HashWords(u32 hash, const void *data, u32 size)
+{
+    const u32 *words = data;
+    const u32 *end = words + size / sizeof(u32);
+
+    while (words < end)
+        hash = HashWord(hash, *words++);
+    return hash;
+}
+
 u8 CreateInvisibleSpriteWithCallback(void (*)(struct Sprite *));
 void StoreWordInTwoHalfwords(u16 *, u32);
 void LoadWordFromTwoHalfwords(u16 *, u32 *);
@@ -76,6 +76,8 @@ bool8 TryStandardWildEncounter(u32 currMetatileAttrs);
 bool8 TryDoDoubleWildBattle(void);
 u32 CalculateChainFishingShinyRolls(void);
 void CreateWildMon(u16 species, u8 level, u8 unownSlot);
+u16 GetWildMonHeaderIdForMap(u32 mapGroup, u32 mapNum);
+bool32 CanSpeciesBeInWildMonHeader(u32 species, u32 headerId);
 u16 GetCurrentMapWildMonHeaderId(void);
 u8 ChooseWildMonIndex_Land(void);
 u8 ChooseWildMonIndex_WaterRock(void);
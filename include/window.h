@@ -55,6 +55,7 @@ void RemoveWindow(u32 windowId);
 void FreeAllWindowBuffers(void);
 void CopyWindowToVram(u32 windowId, u32 mode);
 void CopyWindowRectToVram(u32 windowId, u32 mode, u32 x, u32 y, u32 w, u32 h);
+void CopyWindowTilesToVram(u32 windowId, u32 firstTile, u32 numTiles);
 void PutWindowTilemap(u32 windowId);
 void PutWindowRectTilemapOverridePalette(u32 windowId, u8 x, u8 y, u8 width, u8 height, u8 palette);
 void ClearWindowTilemap(u32 windowId);
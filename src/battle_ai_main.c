@@ -368,7 +368,8 @@ void SetupAIPredictionData(u32 battler, enum SwitchType switchType)
     gAiLogicData->aiPredictionInProgress = FALSE;
 }
 
-void ComputeBattlerDecisions(u32 battler)
+// Returns TRUE if the AI scored the battler's options.
+bool32 ComputeBattlerDecisions(u32 battler)
 {
     if ((gBattleTypeFlags & BATTLE_TYPE_HAS_AI || IsWildMonSmart())
         && (BattlerHasAi(battler)
@@ -376,7 +377,7 @@ void ComputeBattlerDecisions(u32 battler)
     {
         // If ai is about to flee or chosen to watch player, no need to calc anything
         if (BattlerChoseNonMoveAction())
-            return;
+            return FALSE;
 
         // Risky AI switches aggressively even mid battle
         enum SwitchType switchType = (gAiThinkingStruct->aiFlags[battler] & AI_FLAG_RISKY) ? SWITCH_AFTER_KO : SWITCH_MID_BATTLE;
@@ -398,7 +399,9 @@ void ComputeBattlerDecisions(u32 battler)
         ModifySwitchAfterMoveScoring(battler);
 
         gAiLogicData->aiCalcInProgress = FALSE;
+        return TRUE;
     }
+    return FALSE;
 }
 
 void ReconsiderGimmick(u32 battlerAtk, u32 battlerDef, u16 move)
@@ -562,28 +565,29 @@ static u32 Ai_SetMoveAccuracy(struct AiLogicData *aiData, u32 battlerAtk, u32 ba
     return accuracy;
 }
 
-static void CalcBattlerAiMovesData(struct AiLogicData *aiData, u32 battlerAtk, u32 battlerDef, u32 weather)
+static void CalcBattlerAiMoveData(struct AiLogicData *aiData, u32 battlerAtk, u32 battlerDef, u32 moveIndex, u32 weather)
 {
-    u32 moveIndex, move;
-    u16 *moves = GetMovesArray(battlerAtk);
-    u32 moveLimitations = aiData->moveLimitations[battlerAtk];
+    struct SimulatedDamage dmg = {0};
+    uq4_12_t effectiveness = Q_4_12(0.0);
+    u32 move = GetMovesArray(battlerAtk)[moveIndex];
 
-    for (moveIndex = 0; moveIndex < MAX_MON_MOVES; moveIndex++)
-    {
-        struct SimulatedDamage dmg = {0};
-        uq4_12_t effectiveness = Q_4_12(0.0);
-        move = moves[moveIndex];
+    if (IsMoveUnusable(moveIndex, move, aiData->moveLimitations[battlerAtk]))
+        return;
 
-        if (IsMoveUnusable(moveIndex, move, moveLimitations))
-            continue;
+    // Also get effectiveness of status moves
+    dmg = AI_CalcDamage(move, battlerAtk, battlerDef, &effectiveness, USE_GIMMICK, NO_GIMMICK, weather);
+    aiData->moveAccuracy[battlerAtk][battlerDef][moveIndex] = Ai_SetMoveAccuracy(aiData, battlerAtk, battlerDef, move);
 
-        // Also get effectiveness of status moves
-        dmg = AI_CalcDamage(move, battlerAtk, battlerDef, &effectiveness, USE_GIMMICK, NO_GIMMICK, weather);
-        aiData->moveAccuracy[battlerAtk][battlerDef][moveIndex] = Ai_SetMoveAccuracy(aiData, battlerAtk, battlerDef, move);
+    aiData->simulatedDmg[battlerAtk][battlerDef][moveIndex] = dmg;
+    aiData->effectiveness[battlerAtk][battlerDef][moveIndex] = effectiveness;
+}
 
-        aiData->simulatedDmg[battlerAtk][battlerDef][moveIndex] = dmg;
-        aiData->effectiveness[battlerAtk][battlerDef][moveIndex] = effectiveness;
-    }
+static void CalcBattlerAiMovesData(struct AiLogicData *aiData, u32 battlerAtk, u32 battlerDef, u32 weather)
+{
+    u32 moveIndex;
+
+    for (moveIndex = 0; moveIndex < MAX_MON_MOVES; moveIndex++)
+        CalcBattlerAiMoveData(aiData, battlerAtk, battlerDef, moveIndex, weather);
 }
 
 static void SetBattlerAiMovesData(struct AiLogicData *aiData, u32 battlerAtk, u32 battlersCount, u32 weather)
@@ -606,6 +610,29 @@ static void SetBattlerAiMovesData(struct AiLogicData *aiData, u32 battlerAtk, u3
     RestoreBattlerData(battlerAtk);
 }
 
+// Hashes the battle state the damage simulations and SetBattlerAiData read. Nothing in the battle
+// runs while the simulations are pending, so this only changes if something else touches the battle.
+static u32 HashAiSimulationInputs(void)
+{
+    u32 hash = FNV1A_INITIAL_HASH;
+
+    hash = HashWords(hash, gBattleMons, sizeof(gBattleMons));
+    hash = HashWords(hash, gDisableStructs, sizeof(gDisableStructs));
+    hash = HashWords(hash, gProtectStructs, sizeof(gProtectStructs));
+    hash = HashWords(hash, gStatuses3, sizeof(gStatuses3));
+    hash = HashWords(hash, gStatuses4, sizeof(gStatuses4));
+    hash = HashWords(hash, gSideStatuses, sizeof(gSideStatuses));
+    hash = HashWords(hash, gSideTimers, sizeof(gSideTimers));
+    hash = HashWords(hash, &gFieldTimers, sizeof(gFieldTimers));
+    hash = HashWords(hash, gLastMoves, sizeof(gLastMoves));
+    hash = HashWords(hash, gBattlerPartyIndexes, sizeof(gBattlerPartyIndexes));
+    hash = HashWords(hash, gAiPartyData, sizeof(*gAiPartyData));
+    hash = HashWord(hash, gFieldStatuses);
+    hash = HashWord(hash, gBattleWeather);
+    hash = HashWord(hash, gBattlersCount);
+    return hash;
+}
+
 void SetAiLogicDataForTurn(struct AiLogicData *aiData)
 {
     u32 battlerAtk, battlersCount, weather;
@@ -634,12 +661,22 @@ void SetAiLogicDataForTurn(struct AiLogicData *aiData)
         SetBattlerAiData(battlerAtk, aiData);
     }
 
-    for (battlerAtk = 0; battlerAtk < battlersCount; battlerAtk++)
+    if (AI_DAMAGE_SIMULATIONS_PER_FRAME == 0)
     {
-        if (!IsBattlerAlive(battlerAtk))
-            continue;
+        for (battlerAtk = 0; battlerAtk < battlersCount; battlerAtk++)
+        {
+            if (!IsBattlerAlive(battlerAtk))
+                continue;
 
-        SetBattlerAiMovesData(aiData, battlerAtk, battlersCount, weather);
+            SetBattlerAiMovesData(aiData, battlerAtk, battlersCount, weather);
+        }
+    }
+    else
+    {
+        // The damage simulations are spread over the following frames by ContinueAiLogicDataForTurn
+        aiData->simulationWeather = weather;
+        aiData->simulationInputsHash = HashAiSimulationInputs();
+        aiData->simulationsPending = TRUE;
     }
     if (DEBUG_AI_DELAY_TIMER)
         // We add to existing to compound multiple calls
@@ -647,6 +684,72 @@ void SetAiLogicDataForTurn(struct AiLogicData *aiData)
     gAiLogicData->aiCalcInProgress = FALSE;
 }
 
+// Finds the next attacker/target pair that needs its moves simulated, starting from the current one.
+static bool32 SeekNextAiSimulation(struct AiLogicData *aiData)
+{
+    for (; aiData->simulationBattlerAtk < gBattlersCount; aiData->simulationBattlerAtk++, aiData->simulationBattlerDef = 0)
+    {
+        if (!IsBattlerAlive(aiData->simulationBattlerAtk))
+            continue;
+
+        for (; aiData->simulationBattlerDef < gBattlersCount; aiData->simulationBattlerDef++, aiData->simulationMoveIndex = 0)
+        {
+            if (aiData->simulationBattlerAtk == aiData->simulationBattlerDef || !IsBattlerAlive(aiData->simulationBattlerDef))
+                continue;
+            if (aiData->simulationMoveIndex < MAX_MON_MOVES)
+                return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+// Runs up to AI_DAMAGE_SIMULATIONS_PER_FRAME of the damage simulations started by SetAiLogicDataForTurn.
+// Returns TRUE once all of them are done, so the AI can start choosing actions.
+bool32 ContinueAiLogicDataForTurn(struct AiLogicData *aiData)
+{
+    u32 battlerAtk, battlerDef, budget = AI_DAMAGE_SIMULATIONS_PER_FRAME;
+
+    if (!aiData->simulationsPending)
+        return TRUE;
+
+    // The per-battler data and the finished simulations are only valid for the state they were taken from.
+    if (aiData->simulationInputsHash != HashAiSimulationInputs())
+    {
+        SetAiLogicDataForTurn(aiData);
+        if (!aiData->simulationsPending)
+            return TRUE;
+    }
+
+    aiData->aiCalcInProgress = TRUE;
+    if (DEBUG_AI_DELAY_TIMER)
+        CycleCountStart();
+    while (budget != 0 && SeekNextAiSimulation(aiData))
+    {
+        battlerAtk = aiData->simulationBattlerAtk;
+        battlerDef = aiData->simulationBattlerDef;
+
+        // Assumed battler data is only swapped in for the simulations done this frame,
+        // so the real data is in place for anything else that runs in between.
+        SaveBattlerData(battlerAtk);
+        SetBattlerData(battlerAtk);
+        SaveBattlerData(battlerDef);
+        SetBattlerData(battlerDef);
+        for (; budget != 0 && aiData->simulationMoveIndex < MAX_MON_MOVES; aiData->simulationMoveIndex++, budget--)
+            CalcBattlerAiMoveData(aiData, battlerAtk, battlerDef, aiData->simulationMoveIndex, aiData->simulationWeather);
+        RestoreBattlerData(battlerDef);
+        RestoreBattlerData(battlerAtk);
+    }
+    if (DEBUG_AI_DELAY_TIMER)
+        gBattleStruct->aiDelayCycles += CycleCountEnd();
+    aiData->aiCalcInProgress = FALSE;
+
+    if (SeekNextAiSimulation(aiData))
+        return FALSE;
+
+    aiData->simulationsPending = FALSE;
+    return TRUE;
+}
+
 u32 GetPartyMonAbility(struct Pokemon *mon)
 {
     //  Doesn't have any special handling yet
@@ -670,6 +773,7 @@ static u32 PpStallReduction(u32 move, u32 battlerAtk)
         if (currentStallValue == 0 || GetMonData(&gPlayerParty[partyIndex], MON_DATA_HP) == 0)
             continue;
         PokemonToBattleMon(&gPlayerParty[partyIndex], &gBattleMons[tempBattleMonIndex]);
+        InvalidateAbilityCache();
         u32 species = GetMonData(&gPlayerParty[partyIndex], MON_DATA_SPECIES);
         u32 abilityAtk = ABILITY_NONE;
         u32 abilityDef = GetPartyMonAbility(&gPlayerParty[partyIndex]);
@@ -689,6 +793,7 @@ static u32 PpStallReduction(u32 move, u32 battlerAtk)
     }
 
     memcpy(&gBattleMons[tempBattleMonIndex], &backupBattleMon, sizeof(struct BattlePokemon));
+    InvalidateAbilityCache();
 
     return returnValue;
 }
@@ -930,6 +1035,7 @@ void BattleAI_DoAIProcessing_PredictedSwitchin(struct AiThinkingStruct *aiThink,
     // Get battler and move data for predicted switchin
     PokemonToBattleMon(&party[aiData->mostSuitableMonId[battlerDef]], &switchinCandidate);
     gBattleMons[battlerDef] = switchinCandidate;
+    InvalidateAbilityCache();
     SetBattlerAiData(battlerDef, aiData);
     CalcBattlerAiMovesData(aiData, battlerAtk, battlerDef, AI_GetWeather());
 
@@ -955,6 +1061,7 @@ void BattleAI_DoAIProcessing_PredictedSwitchin(struct AiThinkingStruct *aiThink,
 
                 // Restore old switchout data
                 gBattleMons[battlerDef] = switchoutCandidate;
+                InvalidateAbilityCache();
                 SetBattlerAiData(battlerDef, aiData);
                 aiData->simulatedDmg[battlerAtk][battlerDef][aiThink->movesetIndex] = simulatedDamageSwitchout[aiThink->movesetIndex];
                 aiData->effectiveness[battlerAtk][battlerDef][aiThink->movesetIndex] = effectivenessSwitchout[aiThink->movesetIndex];
@@ -973,6 +1080,7 @@ void BattleAI_DoAIProcessing_PredictedSwitchin(struct AiThinkingStruct *aiThink,
 
                 // Restore new switchin data
                 gBattleMons[battlerDef] = switchinCandidate;
+                InvalidateAbilityCache();
                 SetBattlerAiData(battlerDef, aiData);
                 aiData->simulatedDmg[battlerAtk][battlerDef][aiThink->movesetIndex] = simulatedDamageSwitchin[aiThink->movesetIndex];
                 aiData->effectiveness[battlerAtk][battlerDef][aiThink->movesetIndex] = effectivenessSwitchin[aiThink->movesetIndex];
@@ -308,6 +308,7 @@ void SetBattlerData(u32 battlerId)
         // The ability is unknown.
         else
             gBattleMons[battlerId].ability = ABILITY_NONE;
+        InvalidateAbilityCache();
 
         if (gAiPartyData->mons[side][gBattlerPartyIndexes[battlerId]].heldEffect == 0)
             gBattleMons[battlerId].item = 0;
@@ -328,6 +329,7 @@ void RestoreBattlerData(u32 battlerId)
 
         gAiThinkingStruct->saved[battlerId].saved = FALSE;
         gBattleMons[battlerId].ability = gAiThinkingStruct->saved[battlerId].ability;
+        InvalidateAbilityCache();
         gBattleMons[battlerId].item = gAiThinkingStruct->saved[battlerId].heldItem;
         gBattleMons[battlerId].species = gAiThinkingStruct->saved[battlerId].species;
         for (i = 0; i < 4; i++)
@@ -737,9 +739,9 @@ static inline bool32 ShouldCalcCritDamage(u32 battlerAtk, u32 battlerDef, u32 mo
     return FALSE;
 }
 
-struct SimulatedDamage AI_CalcDamage(u32 move, u32 battlerAtk, u32 battlerDef, uq4_12_t *typeEffectiveness, enum AIConsiderGimmick considerGimmickAtk, enum AIConsiderGimmick considerGimmickDef, u32 weather)
+static struct SimulatedDamage AI_CalcDamageUncached(u32 move, u32 battlerAtk, u32 battlerDef, uq4_12_t *typeEffectiveness, enum AIConsiderGimmick considerGimmickAtk, enum AIConsiderGimmick considerGimmickDef, u32 weather)
 {
-    struct SimulatedDamage simDamage;
+    struct SimulatedDamage simDamage = {0};
     enum BattleMoveEffects moveEffect = GetMoveEffect(move);
     bool32 isDamageMoveUnusable = FALSE;
     bool32 toggledGimmickAtk = FALSE;
@@ -857,6 +859,154 @@ struct SimulatedDamage AI_CalcDamage(u32 move, u32 battlerAtk, u32 battlerDef, u
     return simDamage;
 }
 
+#if AI_DAMAGE_CACHE
+static void GetAiDamageBattlerKey(u32 battler, struct AiDamageBattlerKey *key)
+{
+    memset(key, 0, sizeof(*key));
+    memcpy(&key->mon, &gBattleMons[battler], sizeof(key->mon));
+    memcpy(&key->disableStruct, &gDisableStructs[battler], sizeof(key->disableStruct));
+    memcpy(&key->protectStruct, &gProtectStructs[battler], sizeof(key->protectStruct));
+    key->status3 = gStatuses3[battler];
+    key->status4 = gStatuses4[battler];
+    key->aiFlags = gAiThinkingStruct->aiFlags[battler];
+    key->ability = gAiLogicData->abilities[battler];
+    key->holdEffect = gAiLogicData->holdEffects[battler];
+    key->timesGotHit = gBattleStruct->timesGotHit[GetBattlerSide(battler)][gBattlerPartyIndexes[battler]];
+    key->bonusCritStages = gBattleStruct->bonusCritStages[battler];
+    key->sameMoveTurns = gBattleStruct->sameMoveTurns[battler];
+    key->stompingTantrumTimer = gBattleStruct->battlerState[battler].stompingTantrumTimer;
+    key->gimmick = GetActiveGimmick(battler);
+    key->usableGimmick = gBattleStruct->gimmick.usableGimmick[battler];
+    key->partyIndex = gBattlerPartyIndexes[battler];
+}
+
+static void GetAiDamageFieldKey(struct AiDamageFieldKey *key)
+{
+    u32 battler;
+
+    memset(key, 0, sizeof(*key));
+    key->fieldStatuses = gFieldStatuses;
+    key->sideStatuses[B_SIDE_PLAYER] = gSideStatuses[B_SIDE_PLAYER];
+    key->sideStatuses[B_SIDE_OPPONENT] = gSideStatuses[B_SIDE_OPPONENT];
+    memcpy(key->sideTimers, gSideTimers, sizeof(key->sideTimers));
+    key->battlersCount = gBattlersCount;
+    for (battler = 0; battler < gBattlersCount; battler++)
+    {
+        key->abilities[battler] = gBattleMons[battler].ability;
+        key->aiAbilities[battler] = gAiLogicData->abilities[battler];
+        if (gBattleMons[battler].hp != 0)
+            key->aliveBattlers |= 1u << battler;
+    }
+}
+
+// Returns the index of a key equal to the given one, adding it if there is none.
+// Returns AI_DAMAGE_CACHE_KEYS if the table is full.
+static u32 FindAiDamageCacheKey(void *keys, u32 *hashes, u8 *count, const void *key, u32 size)
+{
+    u32 i, hash = HashWords(FNV1A_INITIAL_HASH, key, size);
+
+    for (i = 0; i < *count; i++)
+    {
+        if (hashes[i] == hash && memcmp((const u8 *)keys + i * size, key, size) == 0)
+            return i;
+    }
+
+    if (*count == AI_DAMAGE_CACHE_KEYS)
+        return AI_DAMAGE_CACHE_KEYS;
+
+    memcpy((u8 *)keys + i * size, key, size);
+    hashes[i] = hash;
+    (*count)++;
+    return i;
+}
+
+// Whether AI_CalcDamageUncached would temporarily activate the battler's gimmick.
+static bool32 AI_WillConsiderGimmick(u32 battler, enum AIConsiderGimmick considerGimmick)
+{
+    return considerGimmick == USE_GIMMICK
+        && gBattleStruct->gimmick.usableGimmick[battler] != GIMMICK_NONE
+        && GetActiveGimmick(battler) == GIMMICK_NONE;
+}
+#endif // AI_DAMAGE_CACHE
+
+// For AI decisions made after the turn started, such as picking a
+// replacement for a fainted battler, which SetAiLogicDataForTurn doesn't reset.
+void AI_ClearDamageCache(void)
+{
+#if AI_DAMAGE_CACHE
+    memset(&gAiLogicData->damageCache, 0, sizeof(gAiLogicData->damageCache));
+#endif
+}
+
+struct SimulatedDamage AI_CalcDamage(u32 move, u32 battlerAtk, u32 battlerDef, uq4_12_t *typeEffectiveness, enum AIConsiderGimmick considerGimmickAtk, enum AIConsiderGimmick considerGimmickDef, u32 weather)
+{
+#if AI_DAMAGE_CACHE
+    struct AiDamageCache *cache = &gAiLogicData->damageCache;
+    struct AiDamageCacheEntry *entry;
+    struct AiDamageBattlerKey atkKey, defKey;
+    struct AiDamageFieldKey fieldKey;
+    u32 atkKeyId, defKeyId, fieldKeyId, hash;
+    bool32 gimmickAtk = AI_WillConsiderGimmick(battlerAtk, considerGimmickAtk);
+    bool32 gimmickDef = AI_WillConsiderGimmick(battlerDef, considerGimmickDef);
+
+    GetAiDamageBattlerKey(battlerAtk, &atkKey);
+    GetAiDamageBattlerKey(battlerDef, &defKey);
+    GetAiDamageFieldKey(&fieldKey);
+    atkKeyId = FindAiDamageCacheKey(cache->battlerKeys, cache->battlerKeyHashes, &cache->battlerKeyCount, &atkKey, sizeof(atkKey));
+    defKeyId = FindAiDamageCacheKey(cache->battlerKeys, cache->battlerKeyHashes, &cache->battlerKeyCount, &defKey, sizeof(defKey));
+    fieldKeyId = FindAiDamageCacheKey(cache->fieldKeys, cache->fieldKeyHashes, &cache->fieldKeyCount, &fieldKey, sizeof(fieldKey));
+    if (atkKeyId == AI_DAMAGE_CACHE_KEYS || defKeyId == AI_DAMAGE_CACHE_KEYS || fieldKeyId == AI_DAMAGE_CACHE_KEYS)
+    {
+        // Too many different states this turn, start over. The entries go too since they refer to the keys by index.
+        AI_ClearDamageCache();
+        atkKeyId = FindAiDamageCacheKey(cache->battlerKeys, cache->battlerKeyHashes, &cache->battlerKeyCount, &atkKey, sizeof(atkKey));
+        defKeyId = FindAiDamageCacheKey(cache->battlerKeys, cache->battlerKeyHashes, &cache->battlerKeyCount, &defKey, sizeof(defKey));
+        fieldKeyId = FindAiDamageCacheKey(cache->fieldKeys, cache->fieldKeyHashes, &cache->fieldKeyCount, &fieldKey, sizeof(fieldKey));
+    }
+
+    hash = HashWord(FNV1A_INITIAL_HASH, move | (weather << 16));
+    hash = HashWord(hash, atkKeyId | (defKeyId << 8) | (fieldKeyId << 16));
+    hash = HashWord(hash, battlerAtk | (battlerDef << 2) | (gimmickAtk << 4) | (gimmickDef << 5));
+    entry = &cache->entries[(hash ^ (hash >> 16)) & (AI_DAMAGE_CACHE_SIZE - 1)];
+
+    if (entry->valid
+     && entry->atkKey == atkKeyId
+     && entry->defKey == defKeyId
+     && entry->fieldKey == fieldKeyId
+     && entry->move == move
+     && entry->weather == weather
+     && entry->battlerAtk == battlerAtk
+     && entry->battlerDef == battlerDef
+     && entry->gimmickAtk == gimmickAtk
+     && entry->gimmickDef == gimmickDef)
+    {
+        // Same cleanup as after a calculation
+        gBattleStruct->dynamicMoveType = 0;
+        gBattleStruct->swapDamageCategory = FALSE;
+        gBattleStruct->zmove.baseMoves[battlerAtk] = MOVE_NONE;
+        gAiLogicData->aiCalcInProgress = FALSE;
+        *typeEffectiveness = entry->effectiveness;
+        return entry->dmg;
+    }
+
+    entry->dmg = AI_CalcDamageUncached(move, battlerAtk, battlerDef, &entry->effectiveness, considerGimmickAtk, considerGimmickDef, weather);
+    entry->atkKey = atkKeyId;
+    entry->defKey = defKeyId;
+    entry->fieldKey = fieldKeyId;
+    entry->move = move;
+    entry->weather = weather;
+    entry->battlerAtk = battlerAtk;
+    entry->battlerDef = battlerDef;
+    entry->gimmickAtk = gimmickAtk;
+    entry->gimmickDef = gimmickDef;
+    entry->valid = TRUE;
+    *typeEffectiveness = entry->effectiveness;
+    return entry->dmg;
+#else
+    return AI_CalcDamageUncached(move, battlerAtk, battlerDef, typeEffectiveness, considerGimmickAtk, considerGimmickDef, weather);
+#endif // AI_DAMAGE_CACHE
+}
+
 bool32 AI_IsDamagedByRecoil(u32 battler)
 {
     u32 ability = gAiLogicData->abilities[battler];
@@ -3835,6 +3985,7 @@ struct BattlePokemon *AllocSaveBattleMons(void)
 void FreeRestoreBattleMons(struct BattlePokemon *savedBattleMons)
 {
     memcpy(gBattleMons, savedBattleMons, SIZE_G_BATTLE_MONS);
+    InvalidateAbilityCache();
     Free(savedBattleMons);
 }
 
@@ -3848,6 +3999,7 @@ s32 AI_CalcPartyMonDamage(u32 move, u32 battlerAtk, u32 battlerDef, struct Battl
     if (calcContext == AI_ATTACKING)
     {
         gBattleMons[battlerAtk] = switchinCandidate;
+        InvalidateAbilityCache();
         gAiThinkingStruct->saved[battlerDef].saved = TRUE;
         SetBattlerAiData(battlerAtk, gAiLogicData); // set known opposing battler data
         gAiThinkingStruct->saved[battlerDef].saved = FALSE;
@@ -3855,6 +4007,7 @@ s32 AI_CalcPartyMonDamage(u32 move, u32 battlerAtk, u32 battlerDef, struct Battl
     else if (calcContext == AI_DEFENDING)
     {
         gBattleMons[battlerDef] = switchinCandidate;
+        InvalidateAbilityCache();
         gAiThinkingStruct->saved[battlerAtk].saved = TRUE;
         SetBattlerAiData(battlerDef, gAiLogicData); // set known opposing battler data
         gAiThinkingStruct->saved[battlerAtk].saved = FALSE;
@@ -3893,6 +4046,7 @@ u32 AI_WhoStrikesFirstPartyMon(u32 battlerAtk, u32 battlerDef, struct BattlePoke
 {
     struct BattlePokemon *savedBattleMons = AllocSaveBattleMons();
     gBattleMons[battlerAtk] = switchinCandidate;
+    InvalidateAbilityCache();
 
     SetBattlerAiData(battlerAtk, gAiLogicData);
     u32 aiMonFaster = AI_IsFaster(battlerAtk, battlerDef, moveConsidered);
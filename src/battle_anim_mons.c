@@ -1569,7 +1569,7 @@ s16 CloneBattlerSpriteWithBlend(u8 animBattler)
         {
             if (!gSprites[i].inUse)
             {
-                gSprites[i] = gSprites[spriteId];
+                CloneSpriteAt(i, &gSprites[spriteId]);
                 gSprites[i].oam.objMode = ST_OAM_OBJ_BLEND;
                 gSprites[i].invisible = FALSE;
                 return i;
@@ -2756,6 +2756,7 @@ static void BattleStartClearSetData(void)
 
     TurnValuesCleanUp(FALSE);
     SpecialStatusesClear();
+    InvalidateAbilityCache();
 
     memset(&gDisableStructs, 0, sizeof(gDisableStructs));
     memset(&gFieldTimers, 0, sizeof(gFieldTimers));
@@ -2932,6 +2933,7 @@ void SwitchInClearSetData(u32 battler)
         gBattleMons[battler].status2 = 0;
         gStatuses3[battler] = 0;
         gStatuses4[battler] = 0;
+        InvalidateAbilityCache();
     }
 
     for (i = 0; i < gBattlersCount; i++)
@@ -3030,7 +3032,10 @@ void SwitchInClearSetData(u32 battler)
         u32 side = GetBattlerSide(battler);
         u32 partyIndex = gBattlerPartyIndexes[battler];
         if (TestRunner_Battle_GetForcedAbility(side, partyIndex))
+        {
             gBattleMons[i].ability = gDisableStructs[i].overwrittenAbility = TestRunner_Battle_GetForcedAbility(side, partyIndex);
+            InvalidateAbilityCache();
+        }
     }
     #endif // TESTING
 
@@ -3245,6 +3250,7 @@ static void DoBattleIntro(void)
                 }
                 #endif
             }
+            InvalidateAbilityCache();
 
             // Draw sprite.
             switch (GetBattlerPosition(battler))
@@ -3560,7 +3566,10 @@ static void TryDoEventsBeforeFirstTurn(void)
                 u32 side = GetBattlerSide(i);
                 u32 partyIndex = gBattlerPartyIndexes[i];
                 if (TestRunner_Battle_GetForcedAbility(side, partyIndex))
+                {
                     gBattleMons[i].ability = gDisableStructs[i].overwrittenAbility = TestRunner_Battle_GetForcedAbility(side, partyIndex);
+                    InvalidateAbilityCache();
+                }
             }
         }
         #endif // TESTING
@@ -3935,21 +3944,48 @@ enum
     STATE_SELECTION_SCRIPT_MAY_RUN
 };
 
+// Starts the turn of every battler in order, stopping for the frame after each one the AI scored.
+// Returns TRUE once all of them are started. No controller is asked for an action before then and
+// nothing here draws random numbers in between, so the AI sees the same state as in a single frame.
+static bool32 StartBattlerTurns(void)
+{
+    u32 battler;
+
+    for (battler = 0; battler < gBattlersCount; battler++)
+    {
+        if (gBattleCommunication[battler] != STATE_TURN_START_RECORD)
+            continue;
+
+        RecordedBattle_CopyBattlerMoves(battler); // Recorded battle related action on start of every turn.
+        gBattleCommunication[battler] = STATE_BEFORE_ACTION_CHOSEN;
+        // Do AI score computations here so we can use them in AI_TrySwitchOrUseItem
+        if (ComputeBattlerDecisions(battler))
+        {
+            // STATE_BEFORE_ACTION_CHOSEN resets this right after the scoring, later battlers' AI expects it.
+            gBattleStruct->monToSwitchIntoId[battler] = PARTY_SIZE;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 static void HandleTurnActionSelectionState(void)
 {
     s32 i, battler;
 
+    // Wait for the AI's damage simulations for this turn to finish
+    if (!ContinueAiLogicDataForTurn(gAiLogicData))
+        return;
+    // Then for the AI's scoring, one battler per frame
+    if (!StartBattlerTurns())
+        return;
+
     gBattleCommunication[ACTIONS_CONFIRMED_COUNT] = 0;
     for (battler = 0; battler < gBattlersCount; battler++)
     {
         u32 position = GetBattlerPosition(battler);
         switch (gBattleCommunication[battler])
         {
-        case STATE_TURN_START_RECORD: // Recorded battle related action on start of every turn.
-            RecordedBattle_CopyBattlerMoves(battler);
-            gBattleCommunication[battler] = STATE_BEFORE_ACTION_CHOSEN;
-            ComputeBattlerDecisions(battler); // Do AI score computations here so we can use them in AI_TrySwitchOrUseItem
-            // fallthrough
         case STATE_BEFORE_ACTION_CHOSEN: // Choose an action.
             gBattleStruct->monToSwitchIntoId[battler] = PARTY_SIZE;
             if (gBattleTypeFlags & BATTLE_TYPE_MULTI
@@ -5461,6 +5497,53 @@ static void ReturnFromBattleToOverworld(void)
     SetMainCallback2(gMain.savedCallback);
 }
 
+// A burst of battle script commands stops once it has used this many of
+// the frame's scanlines, leaving time for the rest of the frame.
+#define SCRIPT_COMMAND_BURST_LINES 64
+#define SCANLINES_PER_FRAME        228
+
+// Runs the current battle script command. With B_FLAG_BURST_SCRIPT_COMMANDS
+// set it keeps running commands until a battler controller is busy, a command
+// waits for a later frame (leaves the script pointer alone), the main battle
+// function or current action changes, or the budget is spent. Any of those
+// would have ended the frame's work after one command anyway, so commands
+// still run in the same order. Each extra command burns the random number
+// VBlankIntr would have burnt before it ran on a frame of its own.
+void ExecuteBattleScriptCommands(void)
+{
+    void (*mainFunc)(void) = gBattleMainFunc;
+    u32 actionFuncId = gCurrentActionFuncId;
+    u32 turnActionNumber = gCurrentTurnActionNumber;
+    u32 startLine = REG_VCOUNT;
+    const u8 *instr;
+
+    // Link battles stay in step with the partner.
+    if (B_FLAG_BURST_SCRIPT_COMMANDS == 0
+     || !FlagGet(B_FLAG_BURST_SCRIPT_COMMANDS)
+     || (gBattleTypeFlags & BATTLE_TYPE_LINK))
+    {
+        gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+        return;
+    }
+
+    for (;;)
+    {
+        instr = gBattlescriptCurrInstr;
+        gBattleScriptingCommandsTable[instr[0]]();
+        if (gBattleControllerExecFlags != 0
+         || gBattlescriptCurrInstr == instr
+         || gBattleMainFunc != mainFunc
+         || gCurrentActionFuncId != actionFuncId
+         || gCurrentTurnActionNumber != turnActionNumber
+         || gBattleOutcome != 0
+         || (REG_VCOUNT + SCANLINES_PER_FRAME - startLine) % SCANLINES_PER_FRAME >= SCRIPT_COMMAND_BURST_LINES)
+            return;
+        // The next command would have run on the next frame, after VBlankIntr.
+        if (IsRandomAdvancedOnVBlank())
+            AdvanceRandom();
+    }
+}
+
 void RunBattleScriptCommands_PopCallbacksStack(void)
 {
     if (gCurrentActionFuncId == B_ACTION_TRY_FINISH || gCurrentActionFuncId == B_ACTION_FINISHED)
@@ -5472,14 +5555,14 @@ void RunBattleScriptCommands_PopCallbacksStack(void)
     else
     {
         if (gBattleControllerExecFlags == 0)
-            gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+            ExecuteBattleScriptCommands();
     }
 }
 
 void RunBattleScriptCommands(void)
 {
     if (gBattleControllerExecFlags == 0)
-        gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+        ExecuteBattleScriptCommands();
 }
 
 u32 TrySetAteType(u32 move, u32 battlerAtk, u32 attackerAbility)
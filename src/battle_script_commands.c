@@ -4524,6 +4524,7 @@ static void Cmd_tryfaintmon(void)
          && !IsBattlerAlive(battler))
         {
             gBattleMons[battler].ability = ABILITY_NONE;
+            InvalidateAbilityCache();
             BattleScriptPush(gBattlescriptCurrInstr);
             gBattlescriptCurrInstr = BattleScript_NeutralizingGasExits;
             return;
@@ -5131,6 +5132,7 @@ static void Cmd_getexp(void)
             gBattleStruct->teamGotExpMsgPrinted = FALSE;
             gBattleMons[gBattlerFainted].item = ITEM_NONE;
             gBattleMons[gBattlerFainted].ability = ABILITY_NONE;
+            InvalidateAbilityCache();
             gBattlescriptCurrInstr = cmd->nextInstr;
         }
         break;
@@ -7396,6 +7398,7 @@ static void Cmd_switchindataupdate(void)
             gBattleMons[battler].ability = TestRunner_Battle_GetForcedAbility(side, partyIndex);
     }
     #endif
+    InvalidateAbilityCache();
 
     // check knocked off item
     i = GetBattlerSide(battler);
@@ -9940,6 +9943,7 @@ static void Cmd_various(void)
     {
         VARIOUS_ARGS();
         gBattleMons[battler].ability = gDisableStructs[battler].overwrittenAbility = gBattleStruct->tracedAbility[battler];
+        InvalidateAbilityCache();
         break;
     }
     case VARIOUS_TRY_ILLUSION_OFF:
@@ -10429,6 +10433,7 @@ static void Cmd_various(void)
 
             gBattleScripting.abilityPopupOverwrite = gBattleMons[gBattlerTarget].ability;
             gBattleMons[gBattlerTarget].ability = gDisableStructs[gBattlerTarget].overwrittenAbility = ABILITY_SIMPLE;
+            InvalidateAbilityCache();
             gBattlescriptCurrInstr = cmd->nextInstr;
         }
         return;
@@ -10457,6 +10462,7 @@ static void Cmd_various(void)
             else
             {
                 gBattleMons[gBattlerTarget].ability = gDisableStructs[gBattlerTarget].overwrittenAbility = gBattleMons[gBattlerAttacker].ability;
+                InvalidateAbilityCache();
                 gBattlescriptCurrInstr = cmd->nextInstr;
             }
         }
@@ -13035,6 +13041,7 @@ static void Cmd_transformdataexecution(void)
 
         for (i = 0; i < offsetof(struct BattlePokemon, pp); i++)
             battleMonAttacker[i] = battleMonTarget[i];
+        InvalidateAbilityCache();
 
         gDisableStructs[gBattlerAttacker].overwrittenAbility = GetBattlerAbility(gBattlerTarget);
         for (i = 0; i < MAX_MON_MOVES; i++)
@@ -14813,6 +14820,7 @@ static void Cmd_trycopyability(void)
     {
         gBattleScripting.abilityPopupOverwrite = gBattleMons[battler].ability;
         gBattleMons[battler].ability = gDisableStructs[battler].overwrittenAbility = defAbility;
+        InvalidateAbilityCache();
         gLastUsedAbility = defAbility;
         gBattlescriptCurrInstr = cmd->nextInstr;
     }
@@ -14869,6 +14877,7 @@ static void Cmd_setgastroacid(void)
             gSpecialStatuses[gBattlerTarget].neutralizingGasRemoved = TRUE;
 
         gStatuses3[gBattlerTarget] |= STATUS3_GASTRO_ACID;
+        InvalidateAbilityCache();
         gBattlescriptCurrInstr = cmd->nextInstr;
     }
 }
@@ -14982,6 +14991,7 @@ static void Cmd_tryswapabilities(void)
             gLastUsedAbility = gBattleMons[gBattlerTarget].ability;
             gBattleMons[gBattlerTarget].ability = gDisableStructs[gBattlerTarget].overwrittenAbility = gBattleMons[gBattlerAttacker].ability;
             gBattleMons[gBattlerAttacker].ability = gDisableStructs[gBattlerAttacker].overwrittenAbility = gLastUsedAbility;
+            InvalidateAbilityCache();
 
             gBattlescriptCurrInstr = cmd->nextInstr;
         }
@@ -15165,6 +15175,7 @@ static void Cmd_switchoutabilities(void)
     if (gBattleMons[battler].ability == ABILITY_NEUTRALIZING_GAS)
     {
         gBattleMons[battler].ability = ABILITY_NONE;
+        InvalidateAbilityCache();
         BattleScriptPush(gBattlescriptCurrInstr);
         gBattlescriptCurrInstr = BattleScript_NeutralizingGasExits;
     }
@@ -16421,6 +16432,7 @@ static void Cmd_tryworryseed(void)
 
         gBattleScripting.abilityPopupOverwrite = gBattleMons[gBattlerTarget].ability;
         gBattleMons[gBattlerTarget].ability = gDisableStructs[gBattlerTarget].overwrittenAbility = ABILITY_INSOMNIA;
+        InvalidateAbilityCache();
         gBattlescriptCurrInstr = cmd->nextInstr;
     }
 }
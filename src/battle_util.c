@@ -75,6 +75,19 @@ extern const u8 *const gBattlescriptsForRunningByItem[];
 extern const u8 *const gBattlescriptsForUsingItem[];
 extern const u8 *const gBattlescriptsForSafariActions[];
 
+// The parts of ability lookups that need a scan of every battler.
+// Anything that writes an ability, Gastro Acid or a whole gBattleMons entry calls InvalidateAbilityCache.
+// Fainting, Ability Shield and Mold Breaker are still checked on every query.
+struct AbilityCache
+{
+    bool8 valid;
+    u8 battlersCount;
+    u8 neutralizingGas; // Bit per battler, has Neutralizing Gas and isn't under Gastro Acid
+    u32 fieldAbilities[(ABILITIES_COUNT + 31) / 32]; // Abilities of all battlers, before suppression and fainting
+};
+
+static EWRAM_DATA struct AbilityCache sAbilityCache = {0};
+
 static const u8 sGoNearCounterToCatchFactor[] = {4, 3, 2, 1};
 static const u8 sGoNearCounterToEscapeFactor[] = {4, 4, 4, 4};
 
@@ -4522,6 +4535,7 @@ u32 AbilityBattleEffects(u32 caseID, u32 battler, u32 ability, u32 special, u32
 
                 gLastUsedAbility = gBattleMons[gBattlerAttacker].ability;
                 gBattleMons[gBattlerAttacker].ability = gDisableStructs[gBattlerAttacker].overwrittenAbility = gBattleMons[gBattlerTarget].ability;
+                InvalidateAbilityCache();
                 BattleScriptCall(BattleScript_MummyActivates);
                 effect++;
                 break;
@@ -4544,6 +4558,7 @@ u32 AbilityBattleEffects(u32 caseID, u32 battler, u32 ability, u32 special, u32
                 gLastUsedAbility = gBattleMons[gBattlerAttacker].ability;
                 gBattleMons[gBattlerAttacker].ability = gDisableStructs[gBattlerAttacker].overwrittenAbility = gBattleMons[gBattlerTarget].ability;
                 gBattleMons[gBattlerTarget].ability = gDisableStructs[gBattlerTarget].overwrittenAbility = gLastUsedAbility;
+                InvalidateAbilityCache();
                 BattleScriptCall(BattleScript_WanderingSpiritActivates);
                 effect++;
                 break;
@@ -5351,13 +5366,16 @@ bool32 TryPrimalReversion(u32 battler)
     return FALSE;
 }
 
+static void UpdateAbilityCache(void);
+
 bool32 IsNeutralizingGasOnField(void)
 {
-    u32 i;
+    u32 battlers;
 
-    for (i = 0; i < gBattlersCount; i++)
+    UpdateAbilityCache();
+    for (battlers = sAbilityCache.neutralizingGas; battlers != 0; battlers &= battlers - 1)
     {
-        if (IsBattlerAlive(i) && gBattleMons[i].ability == ABILITY_NEUTRALIZING_GAS && !(gStatuses3[i] & STATUS3_GASTRO_ACID))
+        if (IsBattlerAlive(CountTrailingZeroBits(battlers)))
             return TRUE;
     }
 
@@ -5409,6 +5427,53 @@ u32 GetBattlerAbility(u32 battler)
     return GetBattlerAbilityInternal(battler, FALSE, FALSE);
 }
 
+// Must be called after changing a battler's ability or Gastro Acid, or copying over a gBattleMons entry.
+void InvalidateAbilityCache(void)
+{
+    sAbilityCache.valid = FALSE;
+}
+
+static void UpdateAbilityCache(void)
+{
+    u32 battler;
+
+    if (sAbilityCache.valid && sAbilityCache.battlersCount == gBattlersCount)
+        return;
+
+    sAbilityCache.valid = TRUE;
+    sAbilityCache.battlersCount = gBattlersCount;
+    sAbilityCache.neutralizingGas = 0;
+    memset(sAbilityCache.fieldAbilities, 0, sizeof(sAbilityCache.fieldAbilities));
+    for (battler = 0; battler < gBattlersCount; battler++)
+    {
+        u32 ability = gBattleMons[battler].ability;
+
+        if (ability == ABILITY_NEUTRALIZING_GAS && !(gStatuses3[battler] & STATUS3_GASTRO_ACID))
+            sAbilityCache.neutralizingGas |= 1u << battler;
+        if (ability < ABILITIES_COUNT)
+            sAbilityCache.fieldAbilities[ability / 32] |= 1u << (ability % 32);
+    }
+}
+
+// Mold Breaker records the attacker's ability whenever it's checked, so skipping the per-battler checks is only fine without it.
+static inline bool32 CanSkipAbilityOnFieldChecks(u32 ability)
+{
+    switch (gBattleMons[gBattlerAttacker].ability)
+    {
+    case ABILITY_MOLD_BREAKER:
+    case ABILITY_TERAVOLT:
+    case ABILITY_TURBOBLAZE:
+    case ABILITY_MYCELIUM_MIGHT:
+        return FALSE;
+    }
+
+    UpdateAbilityCache();
+    // Suppression and fainting can only take abilities away, so an ability nobody has can't be on the field.
+    return ability != ABILITY_NONE
+        && ability < ABILITIES_COUNT
+        && !(sAbilityCache.fieldAbilities[ability / 32] & (1u << (ability % 32)));
+}
+
 u32 GetBattlerAbilityInternal(u32 battler, u32 ignoreMoldBreaker, u32 noAbilityShield)
 {
     bool32 hasAbilityShield = !noAbilityShield && GetBattlerHoldEffectIgnoreAbility(battler, TRUE) == HOLD_EFFECT_ABILITY_SHIELD;
@@ -5461,6 +5526,9 @@ u32 IsAbilityOnField(u32 ability)
 {
     u32 i;
 
+    if (CanSkipAbilityOnFieldChecks(ability))
+        return 0;
+
     for (i = 0; i < gBattlersCount; i++)
     {
         if (IsBattlerAlive(i) && GetBattlerAbility(i) == ability)
@@ -5474,6 +5542,9 @@ u32 IsAbilityOnFieldExcept(u32 battler, u32 ability)
 {
     u32 i;
 
+    if (CanSkipAbilityOnFieldChecks(ability))
+        return 0;
+
     for (i = 0; i < gBattlersCount; i++)
     {
         if (i != battler && IsBattlerAlive(i) && GetBattlerAbility(i) == ability)
@@ -7332,7 +7403,7 @@ void ClearVariousBattlerFlags(u32 battler)
 void HandleAction_RunBattleScript(void) // identical to RunBattleScriptCommands
 {
     if (gBattleControllerExecFlags == 0)
-        gBattleScriptingCommandsTable[*gBattlescriptCurrInstr]();
+        ExecuteBattleScriptCommands();
 }
 
 u32 SetRandomTarget(u32 battlerAtk)
@@ -10178,7 +10249,10 @@ bool32 TryBattleFormChange(u32 battler, enum FormChanges method)
             RecalcBattlerStats(battler, &party[monId], method == FORM_CHANGE_BATTLE_GIGANTAMAX);
             // Battler data is not updated with regular form's ability, not doing so could cause wrong ability activation.
             if (method == FORM_CHANGE_FAINT)
+            {
                 gBattleMons[battler].ability = abilityForm;
+                InvalidateAbilityCache();
+            }
             return TRUE;
         }
     }
@@ -10830,6 +10904,7 @@ void CopyMonLevelAndBaseStatsToBattleMon(u32 battler, struct Pokemon *mon)
 void CopyMonAbilityAndTypesToBattleMon(u32 battler, struct Pokemon *mon)
 {
     gBattleMons[battler].ability = GetMonAbility(mon);
+    InvalidateAbilityCache();
     gBattleMons[battler].types[0] = GetSpeciesType(gBattleMons[battler].species, 0);
     gBattleMons[battler].types[1] = GetSpeciesType(gBattleMons[battler].species, 1);
     gBattleMons[battler].types[2] = TYPE_MYSTERY;
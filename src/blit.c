@@ -6,7 +6,8 @@ void BlitBitmapRect4BitWithoutColorKey(const struct Bitmap *src, struct Bitmap *
     BlitBitmapRect4Bit(src, dst, srcX, srcY, dstX, dstY, width, height, 0xFF);
 }
 
-void BlitBitmapRect4Bit(const struct Bitmap *src, struct Bitmap *dst, u16 srcX, u16 srcY, u16 dstX, u16 dstY, u16 width, u16 height, u8 colorKey)
+// Word reads need word-aligned pixels, so other sources go a pixel at a time.
+static void BlitBitmapRect4BitUnaligned(const struct Bitmap *src, struct Bitmap *dst, u16 srcX, u16 srcY, u16 dstX, u16 dstY, u16 width, u16 height, u8 colorKey)
 {
     s32 xEnd;
     s32 yEnd;
@@ -70,12 +71,123 @@ void BlitBitmapRect4Bit(const struct Bitmap *src, struct Bitmap *dst, u16 srcX,
     }
 }
 
-void FillBitmapRect4Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue)
+// Returns 0xF in each nibble of pixels that is not zero.
+static inline u32 NonZeroNibbles(u32 pixels)
+{
+    pixels |= pixels >> 1;
+    pixels |= pixels >> 2;
+    return (pixels & 0x11111111) * 0xF;
+}
+
+// Each row of a 4bpp tile is one word, with the leftmost pixel in the
+// lowest nibble, so 8 pixels are blitted at a time with a mask for the
+// pixels outside of the rectangle or equal to colorKey.
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) void BlitBitmapRect4Bit(const struct Bitmap *src, struct Bitmap *dst, u16 srcX, u16 srcY, u16 dstX, u16 dstY, u16 width, u16 height, u8 colorKey)
+{
+    s32 xEnd;
+    s32 yEnd;
+    s32 dstXEnd;
+    s32 multiplierSrcY;
+    s32 multiplierDstY;
+    s32 loopSrcY, loopDstY;
+    s32 loopX;
+    const u32 *rowSrc;
+    u32 *rowDst;
+    u32 colorKeyBits;
+
+    if ((uintptr_t)src->pixels & 3)
+    {
+        BlitBitmapRect4BitUnaligned(src, dst, srcX, srcY, dstX, dstY, width, height, colorKey);
+        return;
+    }
+
+    if (dst->width - dstX < width)
+        xEnd = (dst->width - dstX) + srcX;
+    else
+        xEnd = srcX + width;
+
+    if (dst->height - dstY < height)
+        yEnd = (dst->height - dstY) + srcY;
+    else
+        yEnd = height + srcY;
+
+    if (xEnd <= srcX)
+        return;
+    dstXEnd = dstX + (xEnd - srcX);
+
+    multiplierSrcY = (src->width + (src->width & 7)) >> 3;
+    multiplierDstY = (dst->width + (dst->width & 7)) >> 3;
+
+    if (colorKey > 0xF && ((srcX | srcY | dstX | dstY | xEnd | yEnd) & 7) == 0)
+    {
+        // Whole tiles are copied a row at a time.
+        for (loopSrcY = srcY, loopDstY = dstY; loopSrcY < yEnd; loopSrcY += 8, loopDstY += 8)
+        {
+            rowSrc = (const u32 *)src->pixels + ((srcX >> 3) << 3) + (((loopSrcY >> 3) * multiplierSrcY) << 3);
+            rowDst = (u32 *)dst->pixels + ((dstX >> 3) << 3) + (((loopDstY >> 3) * multiplierDstY) << 3);
+            for (loopX = srcX; loopX < xEnd; loopX += 8, rowSrc += 8, rowDst += 8)
+            {
+                rowDst[0] = rowSrc[0];
+                rowDst[1] = rowSrc[1];
+                rowDst[2] = rowSrc[2];
+                rowDst[3] = rowSrc[3];
+                rowDst[4] = rowSrc[4];
+                rowDst[5] = rowSrc[5];
+                rowDst[6] = rowSrc[6];
+                rowDst[7] = rowSrc[7];
+            }
+        }
+        return;
+    }
+
+    colorKeyBits = colorKey * 0x11111111u;
+
+    for (loopSrcY = srcY, loopDstY = dstY; loopSrcY < yEnd; loopSrcY++, loopDstY++)
+    {
+        // loopX is the source pixel that lands in the first pixel of each
+        // destination tile, which can be before srcX.
+        s32 tileDstX = dstX & ~7;
+        s32 shift = ((srcX - dstX) & 7) * 4;
+
+        loopX = srcX - (dstX & 7);
+        rowSrc = (const u32 *)src->pixels + (loopX & ~7) + (((loopSrcY >> 3) * multiplierSrcY) << 3) + (loopSrcY & 7);
+        rowDst = (u32 *)dst->pixels + ((dstX >> 3) << 3) + (((loopDstY >> 3) * multiplierDstY) << 3) + (loopDstY & 7);
+        for (; tileDstX < dstXEnd; tileDstX += 8, loopX += 8, rowSrc += 8, rowDst += 8)
+        {
+            s32 first = (tileDstX < dstX) ? dstX - tileDstX : 0;
+            s32 last = (dstXEnd - tileDstX < 8) ? dstXEnd - tileDstX : 8;
+            u32 mask = (0xFFFFFFFF << (first * 4)) & (0xFFFFFFFF >> ((8 - last) * 4));
+            u32 pixels;
+
+            // Only read the source tiles that the masked pixels come from.
+            if (shift == 0)
+            {
+                pixels = rowSrc[0];
+            }
+            else
+            {
+                pixels = 0;
+                if (first * 4 + shift < 32)
+                    pixels = rowSrc[0] >> shift;
+                if (last * 4 + shift > 32)
+                    pixels |= rowSrc[8] << (32 - shift);
+            }
+
+            if (colorKey <= 0xF)
+                mask &= NonZeroNibbles(pixels ^ colorKeyBits);
+            *rowDst = (*rowDst & ~mask) | (pixels & mask);
+        }
+    }
+}
+
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) void FillBitmapRect4Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue)
 {
     s32 xEnd;
     s32 yEnd;
     s32 multiplierY;
     s32 loopX, loopY;
+    u32 fillBits;
+    u32 *row;
 
     xEnd = x + width;
     if (xEnd > surface->width)
@@ -86,23 +198,39 @@ void FillBitmapRect4Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 hei
         yEnd = surface->height;
 
     multiplierY = (surface->width + (surface->width & 7)) >> 3;
+    fillBits = (fillValue & 0xF) * 0x11111111u;
 
-    for (loopY = y; loopY < yEnd; loopY++)
+    if (((x | y | xEnd | yEnd) & 7) == 0)
     {
-        for (loopX = x; loopX < xEnd; loopX++)
+        // Whole tiles are filled a row at a time.
+        for (loopY = y; loopY < yEnd; loopY += 8)
         {
-            u8 *pixels = surface->pixels + ((loopX >> 1) & 3) + ((loopX >> 3) << 5) + (((loopY >> 3) * multiplierY) << 5) + ((u32)(loopY << 0x1d) >> 0x1B);
-            if ((loopX & 1) != 0)
-            {
-                *pixels &= 0xF;
-                *pixels |= fillValue << 4;
-            }
-            else
+            row = (u32 *)surface->pixels + ((x >> 3) << 3) + (((loopY >> 3) * multiplierY) << 3);
+            for (loopX = x; loopX < xEnd; loopX += 8, row += 8)
             {
-                *pixels &= 0xF0;
-                *pixels |= fillValue;
+                row[0] = fillBits;
+                row[1] = fillBits;
+                row[2] = fillBits;
+                row[3] = fillBits;
+                row[4] = fillBits;
+                row[5] = fillBits;
+                row[6] = fillBits;
+                row[7] = fillBits;
             }
         }
+        return;
+    }
+
+    for (loopY = y; loopY < yEnd; loopY++)
+    {
+        row = (u32 *)surface->pixels + ((x >> 3) << 3) + (((loopY >> 3) * multiplierY) << 3) + (loopY & 7);
+        for (loopX = x & ~7; loopX < xEnd; loopX += 8, row += 8)
+        {
+            s32 first = (loopX < x) ? x - loopX : 0;
+            s32 last = (xEnd - loopX < 8) ? xEnd - loopX : 8;
+            u32 mask = (0xFFFFFFFF << (first * 4)) & (0xFFFFFFFF >> ((8 - last) * 4));
+            *row = (*row & ~mask) | (fillBits & mask);
+        }
     }
 }
 
@@ -184,12 +312,16 @@ void BlitBitmapRect4BitTo8Bit(const struct Bitmap *src, struct Bitmap *dst, u16
     }
 }
 
-void FillBitmapRect8Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue)
+// Each row of an 8bpp tile is two words, with the leftmost pixel in the
+// lowest byte, so 4 pixels are filled at a time.
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) void FillBitmapRect8Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue)
 {
     s32 xEnd;
     s32 yEnd;
     s32 multiplierY;
     s32 loopX, loopY;
+    u32 fillBits;
+    u32 *row;
 
     xEnd = x + width;
     if (xEnd > surface->width)
@@ -200,13 +332,18 @@ void FillBitmapRect8Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 hei
         yEnd = surface->height;
 
     multiplierY = (surface->width + (surface->width & 7)) >> 3;
+    fillBits = fillValue * 0x01010101u;
 
     for (loopY = y; loopY < yEnd; loopY++)
     {
-        for (loopX = x; loopX < xEnd; loopX++)
+        row = (u32 *)surface->pixels + (((loopY >> 3) * multiplierY) << 4) + ((loopY & 7) << 1);
+        for (loopX = x & ~3; loopX < xEnd; loopX += 4)
         {
-            u8 *pixels = surface->pixels + (loopX & 7) + ((loopX >> 3) << 6) + (((loopY >> 3) * multiplierY) << 6) + ((u32)(loopY << 0x1d) >> 0x1a);
-            *pixels = fillValue;
+            s32 first = (loopX < x) ? x - loopX : 0;
+            s32 last = (xEnd - loopX < 4) ? xEnd - loopX : 4;
+            u32 mask = (0xFFFFFFFF << (first * 8)) & (0xFFFFFFFF >> ((4 - last) * 8));
+            u32 *pixels = row + ((loopX >> 3) << 4) + ((loopX >> 2) & 1);
+            *pixels = (*pixels & ~mask) | (fillBits & mask);
         }
     }
 }
@@ -239,18 +239,4 @@ const union AnimCmd *const gAnims_Trainer[] ={
 #define TRAINER_SPRITE(trainerPic, sprite, size) [TRAINER_PIC_##trainerPic] = {sprite, size, TRAINER_PIC_##trainerPic}
 #define TRAINER_PAL(trainerPic, pal) [TRAINER_PIC_##trainerPic] = {pal, TRAINER_PIC_##trainerPic}
 
-#include "data/trainer_parties.h"
-
-const struct Trainer gTrainers[DIFFICULTY_COUNT][TRAINERS_COUNT] =
-{
-#include "data/trainers.h"
-};
-
-#include "data/partner_parties.h"
-
-const struct Trainer gBattlePartners[DIFFICULTY_COUNT][PARTNER_COUNT] =
-{
-#include "data/battle_partners.h"
-};
-
 #include "data/text/follower_messages.h"
@@ -0,0 +1 @@
+static const u8 MAP_GROUP_COUNT[] = {5, 125, 60, 68, 4, 6, 8, 10, 6, 8, 20, 10, 8, 2, 10, 4, 2, 2, 2, 1, 1, 2, 2, 3, 2, 3, 2, 1, 1, 1, 1, 7, 5, 5, 8, 8, 5, 5, 1, 1, 1, 2, 1, 0};
@@ -611,48 +611,45 @@ static bool8 DexNavPickTile(u8 environment, u8 areaX, u8 areaY, bool8 smallScan)
     s16 botX = topX + areaX;
     s16 botY = topY + areaY;
     u8 i;
-    bool8 nextIter;
     u8 scale = 0;
     u8 weight = 0;
     u8 currMapType = GetCurrentMapType();
-    u32 metatileAttributes;
     u8 tileBuffer = 2;
+    const u32 *encounterMetatiles;
+    struct ObjectEventOccupancy occupancy;
     u8 *xPos = AllocZeroed((botX - topX) * (botY - topY) * sizeof(u8));
     u8 *yPos = AllocZeroed((botX - topX) * (botY - topY) * sizeof(u8));
     u32 iter = 0;
     bool32 ret = FALSE;
 
+    switch (environment)
+    {
+    case ENCOUNTER_TYPE_LAND:
+        encounterMetatiles = GetEncounterMetatileMask(TILE_ENCOUNTER_LAND);
+        break;
+    case ENCOUNTER_TYPE_WATER:
+        encounterMetatiles = GetEncounterMetatileMask(TILE_ENCOUNTER_WATER);
+        break;
+    default:
+        encounterMetatiles = NULL;
+        break;
+    }
+
+    if (TestPlayerAvatarFlags(PLAYER_AVATAR_FLAG_BIKE))
+        tileBuffer = SNEAKING_PROXIMITY + 3;
+    else if (TestPlayerAvatarFlags(PLAYER_AVATAR_FLAG_DASH))
+        tileBuffer = SNEAKING_PROXIMITY + 1;
+
+    BuildObjectEventOccupancy(&occupancy, topX, topY);
+
     // loop through every tile in area and evaluate
-    while (topY < botY)
+    while (encounterMetatiles != NULL && topY < botY)
     {
         while (topX < botX)
         {
-            metatileAttributes = MapGridGetMetatileAttributeAt(topX, topY, METATILE_ATTRIBUTES_ALL);
-            //Check for objects
-            nextIter = FALSE;
-            if (TestPlayerAvatarFlags(PLAYER_AVATAR_FLAG_BIKE))
-                tileBuffer = SNEAKING_PROXIMITY + 3;
-            else if (TestPlayerAvatarFlags(PLAYER_AVATAR_FLAG_DASH))
-                tileBuffer = SNEAKING_PROXIMITY + 1;
-
-            if (GetPlayerDistance(topX, topY) <= tileBuffer)
-            {
-                // tile too close to player
-                topX++;
-                continue;
-            }
-
-            for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
-            {
-                if (gObjectEvents[i].currentCoords.x == topX && gObjectEvents[i].currentCoords.y == topY)
-                {
-                    // cannot be on a tile where an object exists
-                    nextIter = TRUE;
-                    break;
-                }
-            }
-
-            if (nextIter)
+            if (!IS_ENCOUNTER_METATILE(encounterMetatiles, MapGridGetMetatileIdAt(topX, topY))
+             || GetPlayerDistance(topX, topY) <= tileBuffer // tile too close to player
+             || IsObjectEventOccupancySet(&occupancy, topX, topY)) // cannot be on a tile where an object exists
             {
                 topX++;
                 continue;
@@ -662,38 +659,32 @@ static bool8 DexNavPickTile(u8 environment, u8 areaX, u8 areaY, bool8 smallScan)
             switch (environment)
             {
             case ENCOUNTER_TYPE_LAND:
-                if (ExtractMetatileAttribute(metatileAttributes, METATILE_ATTRIBUTE_ENCOUNTER_TYPE) == TILE_ENCOUNTER_LAND)
+                if (currMapType == MAP_TYPE_UNDERGROUND)
                 {
-                    if (currMapType == MAP_TYPE_UNDERGROUND)
-                    {
-                        // inside (cave)
-                        if (IsElevationMismatchAt(gObjectEvents[gPlayerAvatar.spriteId].currentElevation, topX, topY))
-                            break; //occurs at same z coord
-
-                        scale = 440 - (smallScan * 200) - (GetPlayerDistance(topX, topY) / 2)  - (2 * (topX + topY));
-                        weight = ((Random() % scale) < 1) && !MapGridGetCollisionAt(topX, topY);
-                    }
-                    else
-                    {
-                        // outdoors: grass
-                        scale = 100 - (GetPlayerDistance(topX, topY) * 2);
-                        weight = (Random() % scale <= 5) && !MapGridGetCollisionAt(topX, topY);
-                    }
-                }
-                break;
-            case ENCOUNTER_TYPE_WATER:
-                if (ExtractMetatileAttribute(metatileAttributes, METATILE_ATTRIBUTE_ENCOUNTER_TYPE) == TILE_ENCOUNTER_WATER)
-                {
-                    u8 scale = 320 - (smallScan * 200) - (GetPlayerDistance(topX, topY) / 2);
+                    // inside (cave)
                     if (IsElevationMismatchAt(gObjectEvents[gPlayerAvatar.spriteId].currentElevation, topX, topY))
-                        break;
+                        break; //occurs at same z coord
 
-                    weight = (Random() % scale <= 1) && !MapGridGetCollisionAt(topX, topY);
+                    scale = 440 - (smallScan * 200) - (GetPlayerDistance(topX, topY) / 2)  - (2 * (topX + topY));
+                    weight = ((Random() % scale) < 1) && !MapGridGetCollisionAt(topX, topY);
+                }
+                else
+                {
+                    // outdoors: grass
+                    scale = 100 - (GetPlayerDistance(topX, topY) * 2);
+                    weight = (Random() % scale <= 5) && !MapGridGetCollisionAt(topX, topY);
                 }
                 break;
-            default:
+            case ENCOUNTER_TYPE_WATER:
+            {
+                u8 scale = 320 - (smallScan * 200) - (GetPlayerDistance(topX, topY) / 2);
+                if (IsElevationMismatchAt(gObjectEvents[gPlayerAvatar.spriteId].currentElevation, topX, topY))
+                    break;
+
+                weight = (Random() % scale <= 1) && !MapGridGetCollisionAt(topX, topY);
                 break;
             }
+            }
 
             if (weight > 0)
             {
@@ -1398,6 +1398,38 @@ u8 GetObjectEventIdByXY(s16 x, s16 y)
     return i;
 }
 
+// For callers that look up many tiles at once. Object events move during
+// the frame, so the snapshot is only valid until the next one does.
+void BuildObjectEventOccupancy(struct ObjectEventOccupancy *occupancy, s16 left, s16 top)
+{
+    u32 i;
+
+    occupancy->left = left;
+    occupancy->top = top;
+    memset(occupancy->rows, 0, sizeof(occupancy->rows));
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        if (gObjectEvents[i].active)
+        {
+            u32 x = gObjectEvents[i].currentCoords.x - left;
+            u32 y = gObjectEvents[i].currentCoords.y - top;
+            if (x < OBJECT_EVENT_OCCUPANCY_SIZE && y < OBJECT_EVENT_OCCUPANCY_SIZE)
+                occupancy->rows[y] |= 1u << x;
+        }
+    }
+}
+
+bool32 IsObjectEventOccupancySet(const struct ObjectEventOccupancy *occupancy, s16 x, s16 y)
+{
+    u32 column = x - occupancy->left;
+    u32 row = y - occupancy->top;
+
+    if (column >= OBJECT_EVENT_OCCUPANCY_SIZE || row >= OBJECT_EVENT_OCCUPANCY_SIZE)
+        return GetObjectEventIdByXY(x, y) != OBJECT_EVENTS_COUNT;
+
+    return (occupancy->rows[row] >> column) & 1;
+}
+
 static u8 GetObjectEventIdByLocalIdAndMapInternal(u8 localId, u8 mapNum, u8 mapGroupId)
 {
     u8 i;
@@ -3441,7 +3473,7 @@ u8 CopySprite(struct Sprite *sprite, s16 x, s16 y, u8 subpriority)
     {
         if (!gSprites[i].inUse)
         {
-            gSprites[i] = *sprite;
+            CloneSpriteAt(i, sprite);
             gSprites[i].x = x;
             gSprites[i].y = y;
             gSprites[i].subpriority = subpriority;
@@ -3459,7 +3491,7 @@ u8 CreateCopySpriteAt(struct Sprite *sprite, s16 x, s16 y, u8 subpriority)
     {
         if (!gSprites[i].inUse)
         {
-            gSprites[i] = *sprite;
+            CloneSpriteAt(i, sprite);
             gSprites[i].x = x;
             gSprites[i].y = y;
             gSprites[i].subpriority = subpriority;
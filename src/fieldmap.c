@@ -15,12 +15,20 @@ struct ConnectionFlags
     u8 east:1;
 };
 
+struct EncounterMetatileMasks
+{
+    const struct Tileset *primaryTileset;
+    const struct Tileset *secondaryTileset;
+    u32 metatiles[TILE_ENCOUNTER_WATER][NUM_METATILES_TOTAL / 32]; // Indexed by TILE_ENCOUNTER_* - 1
+};
+
 COMMON_DATA struct BackupMapLayout VMap = {0};
 EWRAM_DATA u16 ALIGNED(4) sBackupMapData[VIRTUAL_MAP_SIZE] = {0};
 EWRAM_DATA struct MapHeader gMapHeader = {0};
 EWRAM_DATA struct Camera gCamera = {0};
 static EWRAM_DATA struct ConnectionFlags gMapConnectionFlags = {0};
 EWRAM_DATA u8 gGlobalFieldTintMode = QL_TINT_NONE;
+static EWRAM_DATA struct EncounterMetatileMasks sEncounterMetatileMasks = {0};
 
 static const struct ConnectionFlags sDummyConnectionFlags = {};
 
@@ -450,6 +458,32 @@ static u32 GetAttributeByMetatileIdAndMapLayout(const struct MapLayout *mapLayou
     }
 }
 
+// Returns a bit per metatile id which has the given encounter type in the
+// current map's tilesets. Rebuilt when the tilesets change.
+const u32 *GetEncounterMetatileMask(u32 encounterType)
+{
+    const struct Tileset *primaryTileset = GetPrimaryTileset(gMapHeader.mapLayout);
+    const struct Tileset *secondaryTileset = GetSecondaryTileset(gMapHeader.mapLayout);
+
+    if (sEncounterMetatileMasks.primaryTileset != primaryTileset
+     || sEncounterMetatileMasks.secondaryTileset != secondaryTileset)
+    {
+        u32 i;
+
+        memset(sEncounterMetatileMasks.metatiles, 0, sizeof(sEncounterMetatileMasks.metatiles));
+        for (i = 0; i < NUM_METATILES_TOTAL; i++)
+        {
+            u32 type = GetAttributeByMetatileIdAndMapLayout(gMapHeader.mapLayout, i, METATILE_ATTRIBUTE_ENCOUNTER_TYPE);
+            if (type != TILE_ENCOUNTER_NONE && type <= ARRAY_COUNT(sEncounterMetatileMasks.metatiles))
+                sEncounterMetatileMasks.metatiles[type - 1][i / 32] |= 1u << (i % 32);
+        }
+        sEncounterMetatileMasks.primaryTileset = primaryTileset;
+        sEncounterMetatileMasks.secondaryTileset = secondaryTileset;
+    }
+
+    return sEncounterMetatileMasks.metatiles[encounterType - 1];
+}
+
 void SaveMapView(void)
 {
     s32 i, j;
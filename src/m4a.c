@@ -324,7 +324,9 @@ void MPlayExtender(struct CgbChannel *cgbChans)
 
 void MusicPlayerJumpTableCopy(void)
 {
+#if !NATIVE
     asm("swi 0x2A");
+#endif
 }
 
 void ClearChain(void *x)
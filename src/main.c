@@ -393,7 +393,7 @@ static void VBlankIntr(void)
     m4aSoundMain();
     TryReceiveLinkBattleData();
 
-    if (!gTestRunnerEnabled && (!gMain.inBattle || !(gBattleTypeFlags & (BATTLE_TYPE_LINK | BATTLE_TYPE_FRONTIER | BATTLE_TYPE_RECORDED))))
+    if (IsRandomAdvancedOnVBlank())
         AdvanceRandom();
 
     UpdateWirelessStatusIndicatorSprite();
@@ -402,6 +402,12 @@ static void VBlankIntr(void)
     gMain.intrCheck |= INTR_FLAG_VBLANK;
 }
 
+// Link, Frontier and recorded battles must draw the same numbers on both sides, so they don't burn any per frame.
+bool32 IsRandomAdvancedOnVBlank(void)
+{
+    return !gTestRunnerEnabled && (!gMain.inBattle || !(gBattleTypeFlags & (BATTLE_TYPE_LINK | BATTLE_TYPE_FRONTIER | BATTLE_TYPE_RECORDED)));
+}
+
 void InitFlashTimer(void)
 {
     SetFlashTimerIntr(2, gIntrTable + 0x7);
@@ -4,10 +4,144 @@
 #include "test/test.h"
 #endif
 
+// Free blocks are kept in segregated lists by size, in addition to the list
+// of every block in address order. Sizes below 256 bytes get a list per 16
+// bytes, larger sizes a list per power of two.
+#define NUM_SMALL_FREE_LISTS 16
+#define NUM_FREE_LISTS       (NUM_SMALL_FREE_LISTS + 18 - 8)
+#define MIN_BLOCK_SIZE       sizeof(struct FreeListLinks)
+
+// Stored in the data of free blocks, which is why no block is smaller than
+// MIN_BLOCK_SIZE.
+struct FreeListLinks
+{
+    struct MemBlock *prev;
+    struct MemBlock *next;
+};
+
+#define FREE_LIST_LINKS(block) ((struct FreeListLinks *)(block)->data)
+
 static void *sHeapStart;
 static u32 sHeapSize;
 
 ALIGNED(4) EWRAM_DATA u8 gHeap[HEAP_SIZE] = {0};
+EWRAM_DATA static struct MemBlock *sFreeLists[NUM_FREE_LISTS] = {0};
+EWRAM_DATA static u32 sUsedFreeLists = 0; // Bit per non-empty free list
+#if TESTING
+EWRAM_DATA static struct HeapStats sHeapStats = {0};
+EWRAM_DATA static u32 sFreeBytes = 0;
+#endif
+
+STATIC_ASSERT(NUM_FREE_LISTS <= 32, FreeListsFitInBitmap);
+
+static u32 GetFreeListId(u32 size)
+{
+    if (size < NUM_SMALL_FREE_LISTS * 16)
+        return size / 16;
+    else
+        return NUM_SMALL_FREE_LISTS + (31 - __builtin_clz(size)) - 8;
+}
+
+static void InsertFreeBlock(struct MemBlock *block)
+{
+    u32 listId = GetFreeListId(block->size);
+    struct MemBlock *next = sFreeLists[listId];
+
+    FREE_LIST_LINKS(block)->prev = NULL;
+    FREE_LIST_LINKS(block)->next = next;
+    if (next != NULL)
+        FREE_LIST_LINKS(next)->prev = block;
+    sFreeLists[listId] = block;
+    sUsedFreeLists |= 1 << listId;
+#if TESTING
+    sFreeBytes += block->size;
+#endif
+}
+
+static void RemoveFreeBlock(struct MemBlock *block)
+{
+    struct FreeListLinks *links = FREE_LIST_LINKS(block);
+
+    if (links->prev != NULL)
+    {
+        FREE_LIST_LINKS(links->prev)->next = links->next;
+    }
+    else
+    {
+        u32 listId = GetFreeListId(block->size);
+        sFreeLists[listId] = links->next;
+        if (links->next == NULL)
+            sUsedFreeLists &= ~(1 << listId);
+    }
+
+    if (links->next != NULL)
+        FREE_LIST_LINKS(links->next)->prev = links->prev;
+#if TESTING
+    sFreeBytes -= block->size;
+#endif
+}
+
+// Returns a free block of at least size bytes, or NULL. Only the list for
+// size itself needs searching, every block in a later list is big enough.
+static struct MemBlock *FindFreeBlock(u32 size)
+{
+    u32 listId = GetFreeListId(size);
+    u32 lists;
+    struct MemBlock *block;
+
+    for (block = sFreeLists[listId]; block != NULL; block = FREE_LIST_LINKS(block)->next)
+    {
+        if (block->size >= size)
+            return block;
+    }
+
+    lists = sUsedFreeLists & ~((2u << listId) - 1);
+    if (lists == 0)
+        return NULL;
+
+    return sFreeLists[__builtin_ctz(lists)];
+}
+
+#if TESTING
+static u32 GetLargestFreeBlockSize(void)
+{
+    u32 largest = 0;
+    struct MemBlock *block;
+
+    if (sUsedFreeLists == 0)
+        return 0;
+
+    for (block = sFreeLists[31 - __builtin_clz(sUsedFreeLists)]; block != NULL; block = FREE_LIST_LINKS(block)->next)
+    {
+        if (block->size > largest)
+            largest = block->size;
+    }
+
+    return largest;
+}
+
+static void UpdateHeapStats(void)
+{
+    u32 used = sHeapSize - sFreeBytes;
+    u32 largestFree = GetLargestFreeBlockSize();
+
+    if (used > sHeapStats.peakUsed)
+        sHeapStats.peakUsed = used;
+    if (largestFree < sHeapStats.minLargestFree)
+        sHeapStats.minLargestFree = largestFree;
+    if (sFreeBytes != 0)
+    {
+        u32 fragmentation = 100 * (sFreeBytes - largestFree) / sFreeBytes;
+        if (fragmentation > sHeapStats.maxFragmentation)
+            sHeapStats.maxFragmentation = fragmentation;
+    }
+}
+
+const struct HeapStats *GetHeapStats(void)
+{
+    return &sHeapStats;
+}
+#endif
 
 void PutMemBlockHeader(void *block, struct MemBlock *prev, struct MemBlock *next, u32 size)
 {
@@ -29,8 +163,8 @@ void PutFirstMemBlockHeader(void *block, u32 size)
 
 void *AllocInternal(void *heapStart, u32 size, const char *location)
 {
-    struct MemBlock *pos = (struct MemBlock *)heapStart;
-    struct MemBlock *head = pos;
+    struct MemBlock *head = (struct MemBlock *)heapStart;
+    struct MemBlock *pos;
     struct MemBlock *splitBlock;
     u32 foundBlockSize;
 
@@ -38,78 +172,77 @@ void *AllocInternal(void *heapStart, u32 size, const char *location)
     if (size & 3)
         size = 4 * ((size / 4) + 1);
 
-    for (;;)
+    // Free blocks hold their free list links.
+    if (size < MIN_BLOCK_SIZE)
+        size = MIN_BLOCK_SIZE;
+
+    pos = FindFreeBlock(size);
+    if (pos != NULL)
     {
-        // Loop through the blocks looking for unused block that's big enough.
+        RemoveFreeBlock(pos);
+        foundBlockSize = pos->size;
 
-        if (!pos->allocated)
+        if (foundBlockSize - size < 2 * sizeof(struct MemBlock))
         {
-            foundBlockSize = pos->size;
-
-            if (foundBlockSize >= size)
-            {
-                if (foundBlockSize - size < 2 * sizeof(struct MemBlock))
-                {
-                    // The block isn't much bigger than the requested size,
-                    // so just use it.
-                    pos->allocated = TRUE;
-                }
-                else
-                {
-                    // The block is significantly bigger than the requested
-                    // size, so split the rest into a separate block.
-                    foundBlockSize -= sizeof(struct MemBlock);
-                    foundBlockSize -= size;
-
-                    splitBlock = (struct MemBlock *)(pos->data + size);
+            // The block isn't much bigger than the requested size,
+            // so just use it.
+            pos->allocated = TRUE;
+        }
+        else
+        {
+            // The block is significantly bigger than the requested
+            // size, so split the rest into a separate block.
+            foundBlockSize -= sizeof(struct MemBlock);
+            foundBlockSize -= size;
 
-                    pos->allocated = TRUE;
-                    pos->size = size;
+            splitBlock = (struct MemBlock *)(pos->data + size);
 
-                    PutMemBlockHeader(splitBlock, pos, pos->next, foundBlockSize);
+            pos->allocated = TRUE;
+            pos->size = size;
 
-                    pos->next = splitBlock;
+            PutMemBlockHeader(splitBlock, pos, pos->next, foundBlockSize);
 
-                    if (splitBlock->next != head)
-                        splitBlock->next->prev = splitBlock;
-                }
+            pos->next = splitBlock;
 
-                pos->locationHi = ((uintptr_t)location) >> 14;
-                pos->locationLo = (uintptr_t)location;
+            if (splitBlock->next != head)
+                splitBlock->next->prev = splitBlock;
 
-                return pos->data;
-            }
+            InsertFreeBlock(splitBlock);
         }
 
-        if (pos->next == head)
-        {
+        pos->locationHi = ((uintptr_t)location) >> 14;
+        pos->locationLo = (uintptr_t)location;
+
 #if TESTING
-            const struct MemBlock *head = HeapHead();
-            const struct MemBlock *block = head;
-            do
-            {
-                if (block->allocated)
-                {
-                    const char *location = MemBlockLocation(block);
-                    if (location)
-                        Test_MgbaPrintf("%s: %d bytes allocated", location, block->size);
-                    else
-                        Test_MgbaPrintf("<unknown>: %d bytes allocated", block->size);
-                }
-                block = block->next;
-            }
-            while (block != head);
-            Test_ExitWithResult(TEST_RESULT_ERROR, SourceLine(0), ":L%s:%d, %s: OOM allocating %d bytes", gTestRunnerState.test->filename, SourceLine(0), location, size);
+        UpdateHeapStats();
 #endif
-            if (location)
+        return pos->data;
+    }
+    else
+    {
+#if TESTING
+        const struct MemBlock *block = head;
+        do
+        {
+            if (block->allocated)
             {
-                DebugPrintfLevel(MGBA_LOG_ERROR, "%s: out of memory trying to allocate %d bytes", location, size);
+                const char *location = MemBlockLocation(block);
+                if (location)
+                    Test_MgbaPrintf("%s: %d bytes allocated", location, block->size);
+                else
+                    Test_MgbaPrintf("<unknown>: %d bytes allocated", block->size);
             }
-            AGB_ASSERT(FALSE);
-            return NULL;
+            block = block->next;
         }
-
-        pos = pos->next;
+        while (block != head);
+        Test_ExitWithResult(TEST_RESULT_ERROR, SourceLine(0), ":L%s:%d, %s: OOM allocating %d bytes", gTestRunnerState.test->filename, SourceLine(0), location, size);
+#endif
+        if (location)
+        {
+            DebugPrintfLevel(MGBA_LOG_ERROR, "%s: out of memory trying to allocate %d bytes", location, size);
+        }
+        AGB_ASSERT(FALSE);
+        return NULL;
     }
 }
 
@@ -129,6 +262,7 @@ void FreeInternal(void *heapStart, void *pointer)
         {
             if (!block->next->allocated)
             {
+                RemoveFreeBlock(block->next);
                 block->size += sizeof(struct MemBlock) + block->next->size;
                 block->next->magic = 0;
                 block->next = block->next->next;
@@ -145,6 +279,7 @@ void FreeInternal(void *heapStart, void *pointer)
             {
                 AGB_ASSERT(block->prev->magic == MALLOC_SYSTEM_ID);
 
+                RemoveFreeBlock(block->prev);
                 block->prev->next = block->next;
 
                 if (block->next != head)
@@ -152,8 +287,14 @@ void FreeInternal(void *heapStart, void *pointer)
 
                 block->magic = 0;
                 block->prev->size += sizeof(struct MemBlock) + block->size;
+                block = block->prev;
             }
         }
+
+        InsertFreeBlock(block);
+#if TESTING
+        UpdateHeapStats();
+#endif
     }
 }
 
@@ -203,6 +344,17 @@ void InitHeap(void *heapStart, u32 heapSize)
     sHeapStart = heapStart;
     sHeapSize = heapSize;
     PutFirstMemBlockHeader(heapStart, heapSize);
+    memset(sFreeLists, 0, sizeof(sFreeLists));
+    sUsedFreeLists = 0;
+#if TESTING
+    sFreeBytes = 0;
+#endif
+    InsertFreeBlock(heapStart);
+#if TESTING
+    sHeapStats.peakUsed = 0;
+    sHeapStats.minLargestFree = sFreeBytes;
+    sHeapStats.maxFragmentation = 0;
+#endif
 }
 
 void *Alloc_(u32 size, const char *location)
@@ -245,8 +397,13 @@ const struct MemBlock *HeapHead(void)
 
 const char *MemBlockLocation(const struct MemBlock *block)
 {
+#if NATIVE
+    // Host pointers do not fit in the 25 bits that are stored.
+    return NULL;
+#else
     if (!block->allocated)
         return NULL;
 
     return (const char *)(ROM_START | (block->locationHi << 14) | block->locationLo);
+#endif
 }
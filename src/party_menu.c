@@ -7717,23 +7717,31 @@ static void TryItemHoldFormChange(struct Pokemon *mon)
 
 static void ShiftMoveSlot(struct Pokemon *mon, u8 slotTo, u8 slotFrom)
 {
-    u16 move1 = GetMonData(mon, MON_DATA_MOVE1 + slotTo);
-    u16 move0 = GetMonData(mon, MON_DATA_MOVE1 + slotFrom);
-    u8 pp1 = GetMonData(mon, MON_DATA_PP1 + slotTo);
-    u8 pp0 = GetMonData(mon, MON_DATA_PP1 + slotFrom);
-    u8 ppBonuses = GetMonData(mon, MON_DATA_PP_BONUSES);
+    struct BoxMonView view;
+    u16 move1, move0;
+    u8 pp1, pp0, ppBonuses;
     u8 ppBonusMask1 = gPPUpGetMask[slotTo];
-    u8 ppBonusMove1 = (ppBonuses & ppBonusMask1) >> (slotTo * 2);
+    u8 ppBonusMove1;
     u8 ppBonusMask2 = gPPUpGetMask[slotFrom];
-    u8 ppBonusMove2 = (ppBonuses & ppBonusMask2) >> (slotFrom * 2);
+    u8 ppBonusMove2;
+
+    OpenBoxMonView(&view, &mon->box);
+    move1 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + slotTo, NULL);
+    move0 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + slotFrom, NULL);
+    pp1 = GetBoxMonViewData(&view, MON_DATA_PP1 + slotTo, NULL);
+    pp0 = GetBoxMonViewData(&view, MON_DATA_PP1 + slotFrom, NULL);
+    ppBonuses = GetBoxMonViewData(&view, MON_DATA_PP_BONUSES, NULL);
+    ppBonusMove1 = (ppBonuses & ppBonusMask1) >> (slotTo * 2);
+    ppBonusMove2 = (ppBonuses & ppBonusMask2) >> (slotFrom * 2);
     ppBonuses &= ~ppBonusMask1;
     ppBonuses &= ~ppBonusMask2;
     ppBonuses |= (ppBonusMove1 << (slotFrom * 2)) + (ppBonusMove2 << (slotTo * 2));
-    SetMonData(mon, MON_DATA_MOVE1 + slotTo, &move0);
-    SetMonData(mon, MON_DATA_MOVE1 + slotFrom, &move1);
-    SetMonData(mon, MON_DATA_PP1 + slotTo, &pp0);
-    SetMonData(mon, MON_DATA_PP1 + slotFrom, &pp1);
-    SetMonData(mon, MON_DATA_PP_BONUSES, &ppBonuses);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + slotTo, &move0);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + slotFrom, &move1);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + slotTo, &pp0);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + slotFrom, &pp1);
+    SetBoxMonViewData(&view, MON_DATA_PP_BONUSES, &ppBonuses);
+    CloseBoxMonView(&view);
 }
 
 u32 Party_FirstMonWithMove(u16 moveId)
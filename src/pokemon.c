@@ -1889,23 +1889,14 @@ void CreateEnemyEventMon(void)
 static u16 CalculateBoxMonChecksum(struct BoxPokemon *boxMon)
 {
     u16 checksum = 0;
-    union PokemonSubstruct *substruct0 = GetSubstruct(boxMon, boxMon->personality, 0);
-    union PokemonSubstruct *substruct1 = GetSubstruct(boxMon, boxMon->personality, 1);
-    union PokemonSubstruct *substruct2 = GetSubstruct(boxMon, boxMon->personality, 2);
-    union PokemonSubstruct *substruct3 = GetSubstruct(boxMon, boxMon->personality, 3);
-    s32 i;
-
-    for (i = 0; i < (s32)ARRAY_COUNT(substruct0->raw); i++)
-        checksum += substruct0->raw[i];
-
-    for (i = 0; i < (s32)ARRAY_COUNT(substruct1->raw); i++)
-        checksum += substruct1->raw[i];
-
-    for (i = 0; i < (s32)ARRAY_COUNT(substruct2->raw); i++)
-        checksum += substruct2->raw[i];
+    s32 i, j;
 
-    for (i = 0; i < (s32)ARRAY_COUNT(substruct3->raw); i++)
-        checksum += substruct3->raw[i];
+    // The checksum is a plain sum, so the substruct order doesn't matter.
+    for (i = 0; i < (s32)ARRAY_COUNT(boxMon->secure.substructs); i++)
+    {
+        for (j = 0; j < (s32)ARRAY_COUNT(boxMon->secure.substructs[i].raw); j++)
+            checksum += boxMon->secure.substructs[i].raw[j];
+    }
 
     return checksum;
 }
@@ -1922,25 +1913,34 @@ static u16 CalculateBoxMonChecksum(struct BoxPokemon *boxMon)
 
 void CalculateMonStats(struct Pokemon *mon)
 {
+    struct BoxMonView view;
     s32 oldMaxHP = GetMonData(mon, MON_DATA_MAX_HP, NULL);
     s32 currentHP = GetMonData(mon, MON_DATA_HP, NULL);
-    s32 hpIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_HP) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_HP_IV, NULL);
-    s32 hpEV = GetMonData(mon, MON_DATA_HP_EV, NULL);
-    s32 attackIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_ATK) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_ATK_IV, NULL);
-    s32 attackEV = GetMonData(mon, MON_DATA_ATK_EV, NULL);
-    s32 defenseIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_DEF) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_DEF_IV, NULL);
-    s32 defenseEV = GetMonData(mon, MON_DATA_DEF_EV, NULL);
-    s32 speedIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_SPEED) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_SPEED_IV, NULL);
-    s32 speedEV = GetMonData(mon, MON_DATA_SPEED_EV, NULL);
-    s32 spAttackIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_SPATK) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_SPATK_IV, NULL);
-    s32 spAttackEV = GetMonData(mon, MON_DATA_SPATK_EV, NULL);
-    s32 spDefenseIV = GetMonData(mon, MON_DATA_HYPER_TRAINED_SPDEF) ? MAX_PER_STAT_IVS : GetMonData(mon, MON_DATA_SPDEF_IV, NULL);
-    s32 spDefenseEV = GetMonData(mon, MON_DATA_SPDEF_EV, NULL);
-    u16 species = GetMonData(mon, MON_DATA_SPECIES, NULL);
-    u8 friendship = GetMonData(mon, MON_DATA_FRIENDSHIP, NULL);
-    s32 level = GetLevelFromMonExp(mon);
+    s32 hpIV, hpEV, attackIV, attackEV, defenseIV, defenseEV, speedIV, speedEV;
+    s32 spAttackIV, spAttackEV, spDefenseIV, spDefenseEV;
+    u16 species;
+    u8 friendship;
+    s32 level;
     s32 newMaxHP;
 
+    OpenBoxMonView(&view, &mon->box);
+    hpIV = view.substruct1->hyperTrainedHP ? MAX_PER_STAT_IVS : view.substruct3->hpIV;
+    hpEV = view.substruct2->hpEV;
+    attackIV = view.substruct1->hyperTrainedAttack ? MAX_PER_STAT_IVS : view.substruct3->attackIV;
+    attackEV = view.substruct2->attackEV;
+    defenseIV = view.substruct1->hyperTrainedDefense ? MAX_PER_STAT_IVS : view.substruct3->defenseIV;
+    defenseEV = view.substruct2->defenseEV;
+    speedIV = view.substruct1->hyperTrainedSpeed ? MAX_PER_STAT_IVS : view.substruct3->speedIV;
+    speedEV = view.substruct2->speedEV;
+    spAttackIV = view.substruct1->hyperTrainedSpAttack ? MAX_PER_STAT_IVS : view.substruct3->spAttackIV;
+    spAttackEV = view.substruct2->spAttackEV;
+    spDefenseIV = view.substruct1->hyperTrainedSpDefense ? MAX_PER_STAT_IVS : view.substruct3->spDefenseIV;
+    spDefenseEV = view.substruct2->spDefenseEV;
+    species = GetBoxMonViewData(&view, MON_DATA_SPECIES, NULL);
+    friendship = view.substruct0->friendship;
+    level = GetLevelFromBoxMonViewExp(&view);
+    CloseBoxMonView(&view);
+
     u8 nature = GetMonData(mon, MON_DATA_HIDDEN_NATURE, NULL);
 
     SetMonData(mon, MON_DATA_LEVEL, &level);
@@ -1999,10 +1999,8 @@ void BoxMonToMon(const struct BoxPokemon *src, struct Pokemon *dest)
     SetMonData(dest, MON_DATA_HP, &value);
 }
 
-u8 GetLevelFromMonExp(struct Pokemon *mon)
+static u8 GetLevelFromSpeciesExp(u32 species, u32 exp)
 {
-    u16 species = GetMonData(mon, MON_DATA_SPECIES, NULL);
-    u32 exp = GetMonData(mon, MON_DATA_EXP, NULL);
     s32 level = 1;
 
     while (level <= MAX_LEVEL && gExperienceTables[gSpeciesInfo[species].growthRate][level] <= exp)
@@ -2011,16 +2009,26 @@ u8 GetLevelFromMonExp(struct Pokemon *mon)
     return level - 1;
 }
 
+u8 GetLevelFromMonExp(struct Pokemon *mon)
+{
+    return GetLevelFromBoxMonExp(&mon->box);
+}
+
 u8 GetLevelFromBoxMonExp(struct BoxPokemon *boxMon)
 {
-    u16 species = GetBoxMonData(boxMon, MON_DATA_SPECIES, NULL);
-    u32 exp = GetBoxMonData(boxMon, MON_DATA_EXP, NULL);
-    s32 level = 1;
+    struct BoxMonView view;
+    u8 level;
 
-    while (level <= MAX_LEVEL && gExperienceTables[gSpeciesInfo[species].growthRate][level] <= exp)
-        level++;
+    OpenBoxMonView(&view, boxMon);
+    level = GetLevelFromBoxMonViewExp(&view);
+    CloseBoxMonView(&view);
 
-    return level - 1;
+    return level;
+}
+
+u8 GetLevelFromBoxMonViewExp(struct BoxMonView *view)
+{
+    return GetLevelFromSpeciesExp(GetBoxMonViewData(view, MON_DATA_SPECIES, NULL), view->substruct0->experience);
 }
 
 u16 GiveMoveToMon(struct Pokemon *mon, u16 move)
@@ -2501,6 +2509,37 @@ static union PokemonSubstruct *GetSubstruct(struct BoxPokemon *boxMon, u32 perso
     return substruct;
 }
 
+// Decrypts the box mon and validates its checksum once, so several fields can be accessed
+// through the view's substructs or GetBoxMonViewData/SetBoxMonViewData without paying for
+// the decryption on every access. The box mon must not be accessed any other way until
+// CloseBoxMonView, which updates the checksum if anything was set and encrypts it again.
+void OpenBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon)
+{
+    view->boxMon = boxMon;
+    view->substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
+    view->substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
+    view->substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
+    view->substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
+    view->modified = FALSE;
+
+    DecryptBoxMon(boxMon);
+
+    view->isValid = (CalculateBoxMonChecksum(boxMon) == boxMon->checksum);
+    if (!view->isValid)
+    {
+        boxMon->isBadEgg = TRUE;
+        boxMon->isEgg = TRUE;
+        view->substruct3->isEgg = TRUE;
+    }
+}
+
+void CloseBoxMonView(struct BoxMonView *view)
+{
+    if (view->modified)
+        view->boxMon->checksum = CalculateBoxMonChecksum(view->boxMon);
+    EncryptBoxMon(view->boxMon);
+}
+
 /* GameFreak called GetMonData with either 2 or 3 arguments, for type
  * safety we have a GetMonData macro (in include/pokemon.h) which
  * dispatches to either GetMonData2 or GetMonData3 based on the number
@@ -2581,11 +2620,8 @@ union EvolutionTracker
     struct EvolutionTrackerBitfield asField;
 };
 
-/* GameFreak called GetBoxMonData with either 2 or 3 arguments, for type
- * safety we have a GetBoxMonData macro (in include/pokemon.h) which
- * dispatches to either GetBoxMonData2 or GetBoxMonData3 based on the
- * number of arguments. */
-u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
+// Reads a field through an open view, or decrypts the box mon for just this field if view is NULL.
+static u32 GetBoxMonDataInternal(struct BoxPokemon *boxMon, struct BoxMonView *view, s32 field, u8 *data)
 {
     s32 i;
     u32 retVal = 0;
@@ -2594,23 +2630,20 @@ u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
     struct PokemonSubstruct2 *substruct2 = NULL;
     struct PokemonSubstruct3 *substruct3 = NULL;
     union EvolutionTracker evoTracker;
+    struct BoxMonView ownView;
 
     // Any field greater than MON_DATA_ENCRYPT_SEPARATOR is encrypted and must be treated as such
     if (field > MON_DATA_ENCRYPT_SEPARATOR)
     {
-        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
-        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
-        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
-        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
-
-        DecryptBoxMon(boxMon);
-
-        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
+        if (view == NULL)
         {
-            boxMon->isBadEgg = TRUE;
-            boxMon->isEgg = TRUE;
-            substruct3->isEgg = TRUE;
+            view = &ownView;
+            OpenBoxMonView(view, boxMon);
         }
+        substruct0 = view->substruct0;
+        substruct1 = view->substruct1;
+        substruct2 = view->substruct2;
+        substruct3 = view->substruct3;
 
         switch (field)
         {
@@ -3052,17 +3085,31 @@ u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
         }
     }
 
-    if (field > MON_DATA_ENCRYPT_SEPARATOR)
-        EncryptBoxMon(boxMon);
+    if (view == &ownView)
+        CloseBoxMonView(view);
 
     return retVal;
 }
 
+/* GameFreak called GetBoxMonData with either 2 or 3 arguments, for type
+ * safety we have a GetBoxMonData macro (in include/pokemon.h) which
+ * dispatches to either GetBoxMonData2 or GetBoxMonData3 based on the
+ * number of arguments. */
+u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
+{
+    return GetBoxMonDataInternal(boxMon, NULL, field, data);
+}
+
 u32 GetBoxMonData2(struct BoxPokemon *boxMon, s32 field)
 {
     return GetBoxMonData3(boxMon, field, NULL);
 }
 
+u32 GetBoxMonViewData(struct BoxMonView *view, s32 field, u8 *data)
+{
+    return GetBoxMonDataInternal(view->boxMon, view, field, data);
+}
+
 #define SET8(lhs) (lhs) = *data
 #define SET16(lhs) (lhs) = data[0] + (data[1] << 8)
 #define SET32(lhs) (lhs) = data[0] + (data[1] << 8) + (data[2] << 16) + (data[3] << 24)
@@ -3125,7 +3172,8 @@ void SetMonData(struct Pokemon *mon, s32 field, const void *dataArg)
     }
 }
 
-void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
+// Sets a field through an open view, or decrypts the box mon for just this field if view is NULL.
+static void SetBoxMonDataInternal(struct BoxPokemon *boxMon, struct BoxMonView *view, s32 field, const void *dataArg)
 {
     const u8 *data = dataArg;
 
@@ -3133,24 +3181,27 @@ void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
     struct PokemonSubstruct1 *substruct1 = NULL;
     struct PokemonSubstruct2 *substruct2 = NULL;
     struct PokemonSubstruct3 *substruct3 = NULL;
+    struct BoxMonView ownView;
 
     if (field > MON_DATA_ENCRYPT_SEPARATOR)
     {
-        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
-        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
-        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
-        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
-
-        DecryptBoxMon(boxMon);
+        if (view == NULL)
+        {
+            view = &ownView;
+            OpenBoxMonView(view, boxMon);
+        }
+        substruct0 = view->substruct0;
+        substruct1 = view->substruct1;
+        substruct2 = view->substruct2;
+        substruct3 = view->substruct3;
 
-        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
+        if (!view->isValid)
         {
-            boxMon->isBadEgg = TRUE;
-            boxMon->isEgg = TRUE;
-            substruct3->isEgg = TRUE;
-            EncryptBoxMon(boxMon);
+            if (view == &ownView)
+                CloseBoxMonView(view);
             return;
         }
+        view->modified = TRUE;
 
         switch (field)
         {
@@ -3478,10 +3529,27 @@ void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
         }
     }
 
-    if (field > MON_DATA_ENCRYPT_SEPARATOR)
+    if (view == &ownView)
+        CloseBoxMonView(view);
+}
+
+void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
+{
+    SetBoxMonDataInternal(boxMon, NULL, field, dataArg);
+}
+
+void SetBoxMonViewData(struct BoxMonView *view, s32 field, const void *data)
+{
+    if (field == MON_DATA_PERSONALITY || field == MON_DATA_OT_ID)
     {
-        boxMon->checksum = CalculateBoxMonChecksum(boxMon);
-        EncryptBoxMon(boxMon);
+        // These are the encryption key, so they can only be changed while encrypted.
+        CloseBoxMonView(view);
+        SetBoxMonDataInternal(view->boxMon, NULL, field, data);
+        OpenBoxMonView(view, view->boxMon);
+    }
+    else
+    {
+        SetBoxMonDataInternal(view->boxMon, view, field, data);
     }
 }
 
@@ -3820,14 +3888,19 @@ const struct LevelUpMove *GetSpeciesLevelUpLearnset(u16 species)
     return learnset;
 }
 
-const u16 *GetSpeciesTeachableLearnset(u16 species)
+static const struct TeachableLearnset *GetSpeciesTeachableLearnsetData(u16 species)
 {
-    const u16 *learnset = gSpeciesInfo[SanitizeSpeciesId(species)].teachableLearnset;
+    const struct TeachableLearnset *learnset = gSpeciesInfo[SanitizeSpeciesId(species)].teachableLearnset;
     if (learnset == NULL)
         return gSpeciesInfo[SPECIES_NONE].teachableLearnset;
     return learnset;
 }
 
+const u16 *GetSpeciesTeachableLearnset(u16 species)
+{
+    return GetSpeciesTeachableLearnsetData(species)->moves;
+}
+
 const u16 *GetSpeciesEggMoves(u16 species)
 {
     const u16 *learnset = gSpeciesInfo[SanitizeSpeciesId(species)].eggMoveLearnset;
@@ -3932,6 +4005,7 @@ void CopyPartyMonToBattleData(u32 battler, u32 partyIndex)
     u32 side = GetBattlerSide(battler);
     struct Pokemon *party = GetSideParty(side);
     PokemonToBattleMon(&party[partyIndex], &gBattleMons[battler]);
+    InvalidateAbilityCache();
     gBattleStruct->hpOnSwitchout[side] = gBattleMons[battler].hp;
     UpdateSentPokesToOpponentValue(battler);
     ClearTemporarySpeciesSpriteData(battler, FALSE, FALSE);
@@ -5859,6 +5933,22 @@ static const u16 sUniversalMoves[] =
     MOVE_TERA_BLAST,
 };
 
+// The universal moves take the first teachable indexes.
+STATIC_ASSERT(ARRAY_COUNT(sUniversalMoves) == TEACHABLE_UNIVERSAL_MOVES_COUNT, UniversalMovesMatchTeachableLearnsets);
+
+static u32 GetTeachableMoveIndex(u16 move)
+{
+    if (move >= ARRAY_COUNT(sTeachableMoveIndexes))
+        return 0;
+    return sTeachableMoveIndexes[move];
+}
+
+bool32 IsTeachableMoveUniversal(u16 move)
+{
+    u32 index = GetTeachableMoveIndex(move);
+    return index != 0 && index <= TEACHABLE_UNIVERSAL_MOVES_COUNT;
+}
+
 u8 CanLearnTeachableMove(u16 species, u16 move)
 {
     if (species == SPECIES_EGG)
@@ -5891,42 +5981,40 @@ u8 CanLearnTeachableMove(u16 species, u16 move)
     }
     else
     {
-        u32 i, j;
-        const u16 *teachableLearnset = GetSpeciesTeachableLearnset(species);
-        for (i = 0; i < ARRAY_COUNT(sUniversalMoves); i++)
+        u32 i;
+        u32 index = GetTeachableMoveIndex(move);
+
+        if (index == 0)
+            return FALSE;
+        index--;
+
+        if (index < TEACHABLE_UNIVERSAL_MOVES_COUNT)
         {
-            if (sUniversalMoves[i] == move)
+            if (!gSpeciesInfo[species].tmIlliterate)
             {
-                if (!gSpeciesInfo[species].tmIlliterate)
-                {
-                    if (move == MOVE_TERA_BLAST && GET_BASE_SPECIES_ID(species) == SPECIES_TERAPAGOS)
-                        return FALSE;
-                    if (GET_BASE_SPECIES_ID(species) == SPECIES_PYUKUMUKU && (move == MOVE_HIDDEN_POWER || move == MOVE_RETURN || move == MOVE_FRUSTRATION))
-                        return FALSE;
-                    return TRUE;
-                }
-                else
-                {
-                    const struct LevelUpMove *learnset = GetSpeciesLevelUpLearnset(species);
-
-                    if (P_TM_LITERACY < GEN_6)
-                        return FALSE;
+                if (move == MOVE_TERA_BLAST && GET_BASE_SPECIES_ID(species) == SPECIES_TERAPAGOS)
+                    return FALSE;
+                if (GET_BASE_SPECIES_ID(species) == SPECIES_PYUKUMUKU && (move == MOVE_HIDDEN_POWER || move == MOVE_RETURN || move == MOVE_FRUSTRATION))
+                    return FALSE;
+                return TRUE;
+            }
+            else
+            {
+                const struct LevelUpMove *learnset = GetSpeciesLevelUpLearnset(species);
 
-                    for (j = 0; j < MAX_LEVEL_UP_MOVES && learnset[j].move != LEVEL_UP_MOVE_END; j++)
-                    {
-                        if (learnset[j].move == move)
-                            return TRUE;
-                    }
+                if (P_TM_LITERACY < GEN_6)
                     return FALSE;
+
+                for (i = 0; i < MAX_LEVEL_UP_MOVES && learnset[i].move != LEVEL_UP_MOVE_END; i++)
+                {
+                    if (learnset[i].move == move)
+                        return TRUE;
                 }
+                return FALSE;
             }
         }
-        for (i = 0; teachableLearnset[i] != MOVE_UNAVAILABLE; i++)
-        {
-            if (teachableLearnset[i] == move)
-                return TRUE;
-        }
-        return FALSE;
+
+        return (GetSpeciesTeachableLearnsetData(species)->bits[index / 32] >> (index % 32)) & 1;
     }
 }
 
@@ -2324,13 +2324,18 @@ static u8 PokeSum_Setup_BufferStrings(void)
 
 static void BufferMonInfo(void)
 {
+    struct BoxMonView view;
     u8 tempStr[20];
     u16 dexNum;
     u16 gender;
     u16 heldItem;
     u32 otId;
 
-    dexNum = SpeciesToPokedexNum(GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_SPECIES));
+    // GetMonGender reads the mon on its own, so it has to be called before the view is opened.
+    gender = GetMonGender(&sMonSummaryScreen->currentMon);
+    OpenBoxMonView(&view, &sMonSummaryScreen->currentMon.box);
+
+    dexNum = SpeciesToPokedexNum(GetBoxMonViewData(&view, MON_DATA_SPECIES, NULL));
     if (dexNum == 0xffff)
         StringCopy(sMonSummaryScreen->summary.dexNumStrBuf, gText_PokeSum_DexNoUnknown);
     else
@@ -2340,25 +2345,25 @@ static void BufferMonInfo(void)
 
     if (!sMonSummaryScreen->isEgg)
     {
-        dexNum = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_SPECIES);
+        dexNum = GetBoxMonViewData(&view, MON_DATA_SPECIES, NULL);
         StringCopy(sMonSummaryScreen->summary.speciesNameStrBuf, GetSpeciesName(dexNum));
     }
     else
     {
-        GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_NICKNAME, sMonSummaryScreen->summary.speciesNameStrBuf);
+        GetBoxMonViewData(&view, MON_DATA_NICKNAME, sMonSummaryScreen->summary.speciesNameStrBuf);
+        CloseBoxMonView(&view);
         return;
     }
 
     sMonSummaryScreen->monTypes[0] = gSpeciesInfo[dexNum].types[0];
     sMonSummaryScreen->monTypes[1] = gSpeciesInfo[dexNum].types[1];
-    sMonSummaryScreen->monTypes[2] = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_TERA_TYPE);
+    sMonSummaryScreen->monTypes[2] = GetBoxMonViewData(&view, MON_DATA_TERA_TYPE, NULL);
 
-    GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_NICKNAME, tempStr);
+    GetBoxMonViewData(&view, MON_DATA_NICKNAME, tempStr);
     StringCopyN_Multibyte(sMonSummaryScreen->summary.nicknameStrBuf, tempStr, POKEMON_NAME_LENGTH);
     StringGet_Nickname(sMonSummaryScreen->summary.nicknameStrBuf);
 
-    gender = GetMonGender(&sMonSummaryScreen->currentMon);
-    dexNum = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_SPECIES_OR_EGG);
+    dexNum = GetBoxMonViewData(&view, MON_DATA_SPECIES_OR_EGG, NULL);
 
     if (gender == MON_FEMALE)
         StringCopy(sMonSummaryScreen->summary.genderSymbolStrBuf, gText_FemaleSymbol);
@@ -2371,19 +2376,20 @@ static void BufferMonInfo(void)
         if (StringCompare(sMonSummaryScreen->summary.nicknameStrBuf, gSpeciesInfo[dexNum].speciesName) == 0)
             StringCopy(sMonSummaryScreen->summary.genderSymbolStrBuf, gString_Dummy);
 
-    GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_OT_NAME, tempStr);
+    GetBoxMonViewData(&view, MON_DATA_OT_NAME, tempStr);
     StringCopyN_Multibyte(sMonSummaryScreen->summary.otNameStrBuf, tempStr, PLAYER_NAME_LENGTH);
 
-    ConvertInternationalString(sMonSummaryScreen->summary.otNameStrBuf, GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_LANGUAGE));
+    ConvertInternationalString(sMonSummaryScreen->summary.otNameStrBuf, GetBoxMonViewData(&view, MON_DATA_LANGUAGE, NULL));
 
-    otId = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_OT_ID) & 0xffff;
+    otId = GetBoxMonViewData(&view, MON_DATA_OT_ID, NULL) & 0xffff;
     ConvertIntToDecimalStringN(sMonSummaryScreen->summary.unk306C, otId, STR_CONV_MODE_LEADING_ZEROS, 5);
 
     ConvertIntToDecimalStringN(tempStr, GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_LEVEL), STR_CONV_MODE_LEFT_ALIGN, 3);
     StringCopy(sMonSummaryScreen->summary.levelStrBuf, gText_Lv);
     StringAppendN(sMonSummaryScreen->summary.levelStrBuf, tempStr, 4);
 
-    heldItem = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_HELD_ITEM);
+    heldItem = GetBoxMonViewData(&view, MON_DATA_HELD_ITEM, NULL);
+    CloseBoxMonView(&view);
 
     if (heldItem == ITEM_NONE)
         StringCopy(sMonSummaryScreen->summary.itemNameStrBuf, gText_PokeSum_Item_None);
@@ -2591,9 +2597,11 @@ static void BufferStat(u8 stat)
 
 static void BufferMonSkills(void)
 {
+    struct BoxMonView view;
     u8 level;
     u16 type;
     u16 species;
+    u16 abilityNum;
     u32 exp;
     u32 expToNextLevel;
 
@@ -2604,22 +2612,24 @@ static void BufferMonSkills(void)
     BufferStat(STAT_SPDEF);
     BufferStat(STAT_SPEED);
 
-    exp = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_EXP);
+    OpenBoxMonView(&view, &sMonSummaryScreen->currentMon.box);
+    exp = GetBoxMonViewData(&view, MON_DATA_EXP, NULL);
+    species = GetBoxMonViewData(&view, MON_DATA_SPECIES, NULL);
+    abilityNum = GetBoxMonViewData(&view, MON_DATA_ABILITY_NUM, NULL);
+    CloseBoxMonView(&view);
+
     ConvertIntToDecimalStringN(sMonSummaryScreen->summary.expPointsStrBuf, exp, STR_CONV_MODE_LEFT_ALIGN, 7);
     sMonSkillsPrinterXpos->expStr = GetNumberRightAlign63(sMonSummaryScreen->summary.expPointsStrBuf);
 
     level = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_LEVEL);
     expToNextLevel = 0;
     if (level < 100)
-    {
-        species = GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_SPECIES);
         expToNextLevel = gExperienceTables[gSpeciesInfo[species].growthRate][level + 1] - exp;
-    }
 
     ConvertIntToDecimalStringN(sMonSummaryScreen->summary.expToNextLevelStrBuf, expToNextLevel, STR_CONV_MODE_LEFT_ALIGN, 7);
     sMonSkillsPrinterXpos->toNextLevel = GetNumberRightAlign63(sMonSummaryScreen->summary.expToNextLevelStrBuf);
 
-    type = GetAbilityBySpecies(GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_SPECIES), GetMonData(&sMonSummaryScreen->currentMon, MON_DATA_ABILITY_NUM));
+    type = GetAbilityBySpecies(species, abilityNum);
     StringCopy(sMonSummaryScreen->summary.abilityNameStrBuf, gAbilitiesInfo[type].name);
     StringCopy(sMonSummaryScreen->summary.abilityDescStrBuf, gAbilitiesInfo[type].description);
 
@@ -4148,6 +4158,7 @@ static void SwapMonMoveSlots(void)
     struct Pokemon * partyMons;
     struct Pokemon * mon;
 
+    struct BoxMonView view;
     u16 move1, move2;
     u8 pp1, pp2;
     u8 allMovesPPBonuses;
@@ -4155,14 +4166,15 @@ static void SwapMonMoveSlots(void)
 
     partyMons = sMonSummaryScreen->monList.mons;
     mon = &partyMons[GetLastViewedMonIndex()];
+    OpenBoxMonView(&view, &mon->box);
 
-    move1 = GetMonData(mon, MON_DATA_MOVE1 + sMoveSelectionCursorPos);
-    move2 = GetMonData(mon, MON_DATA_MOVE1 + sMoveSwapCursorPos);
+    move1 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSelectionCursorPos, NULL);
+    move2 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSwapCursorPos, NULL);
 
-    pp1 = GetMonData(mon, MON_DATA_PP1 + sMoveSelectionCursorPos);
-    pp2 = GetMonData(mon, MON_DATA_PP1 + sMoveSwapCursorPos);
+    pp1 = GetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSelectionCursorPos, NULL);
+    pp2 = GetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSwapCursorPos, NULL);
 
-    allMovesPPBonuses = GetMonData(mon, MON_DATA_PP_BONUSES);
+    allMovesPPBonuses = GetBoxMonViewData(&view, MON_DATA_PP_BONUSES, NULL);
 
     move1ppBonus = (allMovesPPBonuses & gPPUpGetMask[sMoveSelectionCursorPos]) >> (sMoveSelectionCursorPos * 2);
     move2ppBonus = (allMovesPPBonuses & gPPUpGetMask[sMoveSwapCursorPos]) >> (sMoveSwapCursorPos * 2);
@@ -4171,11 +4183,12 @@ static void SwapMonMoveSlots(void)
     allMovesPPBonuses &= ~gPPUpGetMask[sMoveSwapCursorPos];
     allMovesPPBonuses |= (move1ppBonus << (sMoveSwapCursorPos * 2)) + (move2ppBonus << (sMoveSelectionCursorPos * 2));
 
-    SetMonData(mon, MON_DATA_MOVE1 + sMoveSelectionCursorPos, (u8 *)&move2);
-    SetMonData(mon, MON_DATA_MOVE1 + sMoveSwapCursorPos, (u8 *)&move1);
-    SetMonData(mon, MON_DATA_PP1 + sMoveSelectionCursorPos, &pp2);
-    SetMonData(mon, MON_DATA_PP1 + sMoveSwapCursorPos, &pp1);
-    SetMonData(mon, MON_DATA_PP_BONUSES, &allMovesPPBonuses);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSelectionCursorPos, (u8 *)&move2);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSwapCursorPos, (u8 *)&move1);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSelectionCursorPos, &pp2);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSwapCursorPos, &pp1);
+    SetBoxMonViewData(&view, MON_DATA_PP_BONUSES, &allMovesPPBonuses);
+    CloseBoxMonView(&view);
 }
 
 static void SwapBoxMonMoveSlots(void)
@@ -4183,6 +4196,7 @@ static void SwapBoxMonMoveSlots(void)
     struct BoxPokemon * boxMons;
     struct BoxPokemon * boxMon;
 
+    struct BoxMonView view;
     u16 move1, move2;
     u8 pp1, pp2;
     u8 allMovesPPBonuses;
@@ -4190,14 +4204,15 @@ static void SwapBoxMonMoveSlots(void)
 
     boxMons = sMonSummaryScreen->monList.boxMons;
     boxMon = &boxMons[GetLastViewedMonIndex()];
+    OpenBoxMonView(&view, boxMon);
 
-    move1 = GetBoxMonData(boxMon, MON_DATA_MOVE1 + sMoveSelectionCursorPos);
-    move2 = GetBoxMonData(boxMon, MON_DATA_MOVE1 + sMoveSwapCursorPos);
+    move1 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSelectionCursorPos, NULL);
+    move2 = GetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSwapCursorPos, NULL);
 
-    pp1 = GetBoxMonData(boxMon, MON_DATA_PP1 + sMoveSelectionCursorPos);
-    pp2 = GetBoxMonData(boxMon, MON_DATA_PP1 + sMoveSwapCursorPos);
+    pp1 = GetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSelectionCursorPos, NULL);
+    pp2 = GetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSwapCursorPos, NULL);
 
-    allMovesPPBonuses = GetBoxMonData(boxMon, MON_DATA_PP_BONUSES);
+    allMovesPPBonuses = GetBoxMonViewData(&view, MON_DATA_PP_BONUSES, NULL);
 
     move1ppBonus = (allMovesPPBonuses & gPPUpGetMask[sMoveSelectionCursorPos]) >> (sMoveSelectionCursorPos * 2);
     move2ppBonus = (allMovesPPBonuses & gPPUpGetMask[sMoveSwapCursorPos]) >> (sMoveSwapCursorPos * 2);
@@ -4206,11 +4221,12 @@ static void SwapBoxMonMoveSlots(void)
     allMovesPPBonuses &= ~gPPUpGetMask[sMoveSwapCursorPos];
     allMovesPPBonuses |= (move1ppBonus << (sMoveSwapCursorPos * 2)) + (move2ppBonus << (sMoveSelectionCursorPos * 2));
 
-    SetBoxMonData(boxMon, MON_DATA_MOVE1 + sMoveSelectionCursorPos, (u8 *)&move2);
-    SetBoxMonData(boxMon, MON_DATA_MOVE1 + sMoveSwapCursorPos, (u8 *)&move1);
-    SetBoxMonData(boxMon, MON_DATA_PP1 + sMoveSelectionCursorPos, &pp2);
-    SetBoxMonData(boxMon, MON_DATA_PP1 + sMoveSwapCursorPos, &pp1);
-    SetBoxMonData(boxMon, MON_DATA_PP_BONUSES, &allMovesPPBonuses);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSelectionCursorPos, (u8 *)&move2);
+    SetBoxMonViewData(&view, MON_DATA_MOVE1 + sMoveSwapCursorPos, (u8 *)&move1);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSelectionCursorPos, &pp2);
+    SetBoxMonViewData(&view, MON_DATA_PP1 + sMoveSwapCursorPos, &pp1);
+    SetBoxMonViewData(&view, MON_DATA_PP_BONUSES, &allMovesPPBonuses);
+    CloseBoxMonView(&view);
 }
 
 static void UpdateCurrentMonBufferFromPartyOrBox(struct Pokemon * mon)
@@ -1650,10 +1650,8 @@ void QL_TryRunActions(void)
                         break;
                     case QL_ACTION_INPUT:
                         // Player input
-                        *(u32 *)&gQuestLogFieldInput = ((sCurSceneActions[gQuestLogCurActionIdx].data.fieldInput[3] << 24)
-                                                      | (sCurSceneActions[gQuestLogCurActionIdx].data.fieldInput[2] << 16)
-                                                      | (sCurSceneActions[gQuestLogCurActionIdx].data.fieldInput[1] << 8)
-                                                      | (sCurSceneActions[gQuestLogCurActionIdx].data.fieldInput[0] << 0));
+                        // Only the first three bytes are a struct FieldInput, the fourth is always 0
+                        memcpy(&gQuestLogFieldInput, sCurSceneActions[gQuestLogCurActionIdx].data.fieldInput, sizeof(gQuestLogFieldInput));
                         break;
                     case QL_ACTION_EMPTY:
                         // End
@@ -20,7 +20,8 @@ static u8 HandleReplaceSector(u16 sectorId, const struct SaveSectorLocation *loc
 static u8 CopySaveSlotData(u16 sectorId, struct SaveSectorLocation *locations);
 static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations);
 static u8 ReadFlashSector(u8 sectorId, struct SaveSector *sector);
-static u16 CalculateChecksum(void *data, u16 size);
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) static u16 CalculateChecksum(void *data, u16 size);
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) static u32 HashSaveSectorPayload(const struct SaveSector *sector);
 static void CopyToSaveBlock3(u32, struct SaveSector *);
 static void CopyFromSaveBlock3(u32, struct SaveSector *);
 
@@ -34,10 +35,14 @@ static void CopyFromSaveBlock3(u32, struct SaveSector *);
  *
  * There are two save slots for saving the player's game data. We alternate between
  * them each time the game is saved, so that if the current save slot is corrupt,
- * we can load the previous one. We also rotate the sectors in each save slot
- * so that the same data is not always being written to the same sector. This
- * might be done to reduce wear on the flash memory, but I'm not sure, since all
- * 14 sectors get written anyway.
+ * we can load the previous one. Link saves also rotate the sectors in each save
+ * slot so that the same data is not always being written to the same sector.
+ *
+ * Normal saves keep the sectors where they are and only rewrite the ones whose
+ * payload changed since that slot was last written (see sSaveSlotHashes).
+ * SaveBlock2 is always written, and written last, so its counter marks the slot
+ * as complete: a slot with a sector newer than its SaveBlock2 sector belongs to
+ * a save that was interrupted, and is treated as corrupt.
  *
  * See SECTOR_ID_* constants in save.h
  */
@@ -77,11 +82,13 @@ struct
 };
 
 // These will produce an error if a save struct is larger than the space
-// alloted for it in the flash.
+// alloted for it in the flash. Host builds lay the structs out differently.
+#if !NATIVE
 STATIC_ASSERT(sizeof(struct SaveBlock3) <= SAVE_BLOCK_3_CHUNK_SIZE * NUM_SECTORS_PER_SLOT, SaveBlock3FreeSpace);
 STATIC_ASSERT(sizeof(struct SaveBlock2) <= SECTOR_DATA_SIZE, SaveBlock2FreeSpace);
 STATIC_ASSERT(sizeof(struct SaveBlock1) <= SECTOR_DATA_SIZE * (SECTOR_ID_SAVEBLOCK1_END - SECTOR_ID_SAVEBLOCK1_START + 1), SaveBlock1FreeSpace);
 STATIC_ASSERT(sizeof(struct PokemonStorage) <= SECTOR_DATA_SIZE * (SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START + 1), PokemonStorageFreeSpace);
+#endif
 
 // Sector num to begin writing save data. Sectors are rotated each time the game is saved. (possibly to avoid wear on flash memory?)
 COMMON_DATA u16 gLastWrittenSector = 0;
@@ -99,6 +106,26 @@ COMMON_DATA u16 gSaveAttemptStatus = 0;
 
 EWRAM_DATA struct SaveSector gSaveDataBuffer = {0};
 
+// Hashes of the sector payloads last written to each save slot. Only valid
+// while nothing but WriteSaveSectorOrSlot has written to the slot, and only
+// for the rotation it was written with.
+struct SaveSlotHashes
+{
+    u32 sectors[NUM_SECTORS_PER_SLOT];
+    u16 rotation;
+    bool16 valid;
+};
+
+static EWRAM_DATA struct SaveSlotHashes sSaveSlotHashes[NUM_SAVE_SLOTS] = {0};
+
+static void InvalidateSaveSlotHashes(void)
+{
+    u32 i;
+
+    for (i = 0; i < NUM_SAVE_SLOTS; i++)
+        sSaveSlotHashes[i].valid = FALSE;
+}
+
 void ClearSaveData(void)
 {
     u16 i;
@@ -109,6 +136,7 @@ void ClearSaveData(void)
         EraseFlashSector(i);
         EraseFlashSector(i + SECTORS_COUNT / 2);
     }
+    InvalidateSaveSlotHashes();
 }
 
 void Save_ResetSaveCounters(void)
@@ -116,6 +144,7 @@ void Save_ResetSaveCounters(void)
     gSaveCounter = 0;
     gLastWrittenSector = 0;
     gDamagedSaveSectors = 0;
+    InvalidateSaveSlotHashes();
 }
 
 static bool32 SetDamagedSectorBits(u8 op, u8 sectorId)
@@ -139,10 +168,57 @@ static bool32 SetDamagedSectorBits(u8 op, u8 sectorId)
     return retVal;
 }
 
+static u16 GetSlotSectorNum(u16 sectorId)
+{
+    // Adjust sector id for current save slot
+    u16 sector = sectorId + gLastWrittenSector;
+    sector %= NUM_SECTORS_PER_SLOT;
+    sector += NUM_SECTORS_PER_SLOT * (gSaveCounter % NUM_SAVE_SLOTS);
+    return sector;
+}
+
+static void FillSaveSector(u16 sectorId, const struct SaveSectorLocation *locations)
+{
+    u8 *data = locations[sectorId].data;
+    u16 size = locations[sectorId].size;
+
+    // Clear temp save sector
+    memset(gReadWriteSector, 0, SECTOR_SIZE);
+
+    // Set footer data
+    gReadWriteSector->id = sectorId;
+    gReadWriteSector->signature = SECTOR_SIGNATURE;
+    gReadWriteSector->counter = gSaveCounter;
+
+    // Copy current data to temp buffer for writing
+    memcpy(gReadWriteSector->data, data, size);
+
+    CopyFromSaveBlock3(sectorId, gReadWriteSector);
+
+    gReadWriteSector->checksum = CalculateChecksum(data, size);
+}
+
+// Writes a sector of the full save slot, unless the slot already holds the
+// same payload for it. SaveBlock2 is always written since it commits the slot.
+static u8 HandleWriteDirtySector(u16 sectorId, const struct SaveSectorLocation *locations, struct SaveSlotHashes *hashes, bool32 canSkip)
+{
+    u32 hash;
+
+    FillSaveSector(sectorId, locations);
+    hash = HashSaveSectorPayload(gReadWriteSector);
+    if (canSkip && sectorId != SECTOR_ID_SAVEBLOCK2 && hashes->sectors[sectorId] == hash)
+        return SAVE_STATUS_OK;
+
+    hashes->sectors[sectorId] = hash;
+    return TryWriteSector(GetSlotSectorNum(sectorId), gReadWriteSector->data);
+}
+
 static u8 WriteSaveSectorOrSlot(u16 sectorId, const struct SaveSectorLocation *locations)
 {
     u32 status;
     u16 i;
+    struct SaveSlotHashes *hashes;
+    bool32 canSkip;
 
     gReadWriteSector = &gSaveDataBuffer;
 
@@ -155,15 +231,19 @@ static u8 WriteSaveSectorOrSlot(u16 sectorId, const struct SaveSectorLocation *l
     else
     {
         // No sector was specified, write full save slot.
+        // The sectors are not rotated so that unchanged ones can be skipped.
         gLastKnownGoodSector = gLastWrittenSector; // backup the current written sector before attempting to write.
         gLastSaveCounter = gSaveCounter;
-        gLastWrittenSector++;
-        gLastWrittenSector = gLastWrittenSector % NUM_SECTORS_PER_SLOT;
         gSaveCounter++;
         status = SAVE_STATUS_OK;
 
-        for (i = 0; i < NUM_SECTORS_PER_SLOT; i++)
-            HandleWriteSector(i, locations);
+        hashes = &sSaveSlotHashes[gSaveCounter % NUM_SAVE_SLOTS];
+        canSkip = hashes->valid && hashes->rotation == gLastWrittenSector;
+        hashes->valid = FALSE;
+
+        // Write SaveBlock2 last, after every other changed sector.
+        for (i = 1; i <= NUM_SECTORS_PER_SLOT; i++)
+            HandleWriteDirtySector(i % NUM_SECTORS_PER_SLOT, locations, hashes, canSkip);
 
         if (gDamagedSaveSectors)
         {
@@ -172,6 +252,11 @@ static u8 WriteSaveSectorOrSlot(u16 sectorId, const struct SaveSectorLocation *l
             gLastWrittenSector = gLastKnownGoodSector;
             gSaveCounter = gLastSaveCounter;
         }
+        else
+        {
+            hashes->rotation = gLastWrittenSector;
+            hashes->valid = TRUE;
+        }
     }
 
     return status;
@@ -179,38 +264,9 @@ static u8 WriteSaveSectorOrSlot(u16 sectorId, const struct SaveSectorLocation *l
 
 static u8 HandleWriteSector(u16 sectorId, const struct SaveSectorLocation *locations)
 {
-    u16 i;
-    u16 sector;
-    u8 *data;
-    u16 size;
-
-    // Adjust sector id for current save slot
-    sector = sectorId + gLastWrittenSector;
-    sector %= NUM_SECTORS_PER_SLOT;
-    sector += NUM_SECTORS_PER_SLOT * (gSaveCounter % NUM_SAVE_SLOTS);
-
-    // Get current save data
-    data = locations[sectorId].data;
-    size = locations[sectorId].size;
-
-    // Clear temp save sector
-    for (i = 0; i < SECTOR_SIZE; i++)
-        ((u8 *)gReadWriteSector)[i] = 0;
-
-    // Set footer data
-    gReadWriteSector->id = sectorId;
-    gReadWriteSector->signature = SECTOR_SIGNATURE;
-    gReadWriteSector->counter = gSaveCounter;
-
-    // Copy current data to temp buffer for writing
-    for (i = 0; i < size; i++)
-        gReadWriteSector->data[i] = data[i];
-
-    CopyFromSaveBlock3(sectorId, gReadWriteSector);
-
-    gReadWriteSector->checksum = CalculateChecksum(data, size);
-
-    return TryWriteSector(sector, gReadWriteSector->data);
+    InvalidateSaveSlotHashes();
+    FillSaveSector(sectorId, locations);
+    return TryWriteSector(GetSlotSectorNum(sectorId), gReadWriteSector->data);
 }
 
 static u8 HandleWriteSectorNBytes(u8 sectorId, u8 *data, u16 size)
@@ -314,36 +370,11 @@ static u8 HandleReplaceSectorAndVerify(u16 sectorId, const struct SaveSectorLoca
 static u8 HandleReplaceSector(u16 sectorId, const struct SaveSectorLocation *locations)
 {
     u16 i;
-    u16 sector;
-    u8 *data;
-    u16 size;
+    u16 sector = GetSlotSectorNum(sectorId);
     u8 status;
 
-    // Adjust sector id for current save slot
-    sector = sectorId + gLastWrittenSector;
-    sector %= NUM_SECTORS_PER_SLOT;
-    sector += NUM_SECTORS_PER_SLOT * (gSaveCounter % NUM_SAVE_SLOTS);
-
-    // Get current save data
-    data = locations[sectorId].data;
-    size = locations[sectorId].size;
-
-    // Clear temp save sector.
-    for (i = 0; i < SECTOR_SIZE; i++)
-        ((u8 *)gReadWriteSector)[i] = 0;
-
-    // Set footer data
-    gReadWriteSector->id = sectorId;
-    gReadWriteSector->signature = SECTOR_SIGNATURE;
-    gReadWriteSector->counter = gSaveCounter;
-
-    // Copy current data to temp buffer for writing
-    for (i = 0; i < size; i++)
-        gReadWriteSector->data[i] = data[i];
-
-    CopyFromSaveBlock3(sectorId, gReadWriteSector);
-
-    gReadWriteSector->checksum = CalculateChecksum(data, size);
+    InvalidateSaveSlotHashes();
+    FillSaveSector(sectorId, locations);
 
     // Erase old save data
     EraseFlashSector(sector);
@@ -519,73 +550,57 @@ static u8 CopySaveSlotData(u16 sectorId, struct SaveSectorLocation *locations)
     return SAVE_STATUS_OK;
 }
 
-static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
+// A slot's save counter is the one of its SaveBlock2 sector, which is written
+// last. Any sector with a newer counter is from an interrupted save.
+static u8 GetSaveSlotStatus(u16 slot, const struct SaveSectorLocation *locations, u32 *saveCounter)
 {
     u16 sector;
-    bool8 signatureValid;
+    u16 id;
+    bool8 signatureValid = FALSE;
     u16 checksum;
-    u32 slot1saveCounter = 0;
-    u32 slot2saveCounter = 0;
-    u8 slot1Status;
-    u8 slot2Status;
-    u32 validSectors;
+    u32 validSectors = 0;
+    u32 counters[NUM_SECTORS_PER_SLOT];
     const u32 ALL_SECTORS = (1 << NUM_SECTORS_PER_SLOT) - 1;  // bitmask of all saveblock sectors
 
-    // check save slot 1.
-    validSectors = 0;
-    signatureValid = FALSE;
     for (sector = 0; sector < NUM_SECTORS_PER_SLOT; sector++)
     {
-        ReadFlashSector(sector, gReadWriteSector);
+        ReadFlashSector(NUM_SECTORS_PER_SLOT * slot + sector, gReadWriteSector);
         if (gReadWriteSector->signature == SECTOR_SIGNATURE)
         {
             signatureValid = TRUE;
-            checksum = CalculateChecksum(gReadWriteSector->data, locations[gReadWriteSector->id].size);
+            id = gReadWriteSector->id;
+            if (id >= NUM_SECTORS_PER_SLOT)
+                continue;
+            checksum = CalculateChecksum(gReadWriteSector->data, locations[id].size);
             if (gReadWriteSector->checksum == checksum)
             {
-                slot1saveCounter = gReadWriteSector->counter;
-                validSectors |= 1 << gReadWriteSector->id;
+                counters[id] = gReadWriteSector->counter;
+                validSectors |= 1 << id;
             }
         }
     }
 
-    if (signatureValid)
-    {
-        if (validSectors == ALL_SECTORS)
-            slot1Status = SAVE_STATUS_OK;
-        else
-            slot1Status = SAVE_STATUS_ERROR;
-    }
-    else
-        slot1Status = SAVE_STATUS_EMPTY;
+    if (!signatureValid)
+        return SAVE_STATUS_EMPTY;
+    if (validSectors != ALL_SECTORS)
+        return SAVE_STATUS_ERROR;
 
-    // check save slot 2.
-    validSectors = 0;
-    signatureValid = FALSE;
-    for (sector = 0; sector < NUM_SECTORS_PER_SLOT; sector++)
+    *saveCounter = counters[SECTOR_ID_SAVEBLOCK2];
+    for (id = 0; id < NUM_SECTORS_PER_SLOT; id++)
     {
-        ReadFlashSector(NUM_SECTORS_PER_SLOT + sector, gReadWriteSector);
-        if (gReadWriteSector->signature == SECTOR_SIGNATURE)
-        {
-            signatureValid = TRUE;
-            checksum = CalculateChecksum(gReadWriteSector->data, locations[gReadWriteSector->id].size);
-            if (gReadWriteSector->checksum == checksum)
-            {
-                slot2saveCounter = gReadWriteSector->counter;
-                validSectors |= 1 << gReadWriteSector->id;
-            }
-        }
+        if ((s32)(counters[id] - *saveCounter) > 0)
+            return SAVE_STATUS_ERROR;
     }
 
-    if (signatureValid)
-    {
-        if (validSectors == ALL_SECTORS)
-            slot2Status = SAVE_STATUS_OK;
-        else
-            slot2Status = SAVE_STATUS_ERROR;
-    }
-    else
-        slot2Status = SAVE_STATUS_EMPTY;
+    return SAVE_STATUS_OK;
+}
+
+static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
+{
+    u32 slot1saveCounter = 0;
+    u32 slot2saveCounter = 0;
+    u8 slot1Status = GetSaveSlotStatus(0, locations, &slot1saveCounter);
+    u8 slot2Status = GetSaveSlotStatus(1, locations, &slot2saveCounter);
 
     if (slot1Status == SAVE_STATUS_OK && slot2Status == SAVE_STATUS_OK)
     {
@@ -667,20 +682,37 @@ static u8 ReadFlashSector(u8 sectorId, struct SaveSector *sector)
     return 1;
 }
 
-static u16 CalculateChecksum(void *data, u16 size)
+// Every sector is checksummed on both save and load, so this runs from IWRAM in ARM mode.
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) static u16 CalculateChecksum(void *data, u16 size)
 {
-    u16 i;
+    const u32 *src = data;
+    const u32 *end = src + size / 4;
     u32 checksum = 0;
 
-    for (i = 0; i < (size / 4); i++)
+    while (src + 4 <= end)
     {
-        checksum += *((u32 *)data);
-        data += sizeof(u32);
+        checksum += src[0] + src[1] + src[2] + src[3];
+        src += 4;
     }
+    while (src < end)
+        checksum += *src++;
 
     return ((checksum >> 16) + checksum);
 }
 
+// FNV-1a over the words of the sector's data and SaveBlock3 chunk, but not its footer.
+ARM_FUNC __attribute__((section(".iwram.code"))) __attribute__((noinline)) static u32 HashSaveSectorPayload(const struct SaveSector *sector)
+{
+    const u32 *src = (const u32 *)sector->data;
+    const u32 *end = (const u32 *)&sector->id;
+    u32 hash = 2166136261;
+
+    while (src < end)
+        hash = (hash ^ *src++) * 16777619;
+
+    return hash;
+}
+
 static void UpdateSaveAddresses(void)
 {
     int i = SECTOR_ID_SAVEBLOCK2;
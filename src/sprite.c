@@ -46,7 +46,7 @@ struct OamDimensions
     s8 height;
 };
 
-static void SortSprites(u32 *spritePriorities, s32 n);
+static u32 *SortSprites(u32 *spritePriorities, u32 *scratch, s32 n);
 static u32 CreateSpriteAt(u32 index, const struct SpriteTemplate *template, s16 x, s16 y, u32 subpriority);
 static void ResetOamMatrices(void);
 static void ResetSprite(struct Sprite *sprite);
@@ -260,7 +260,10 @@ COMMON_DATA u32 gOamMatrixAllocBitmap = 0;
 COMMON_DATA u8 gReservedSpritePaletteCount = 0;
 
 EWRAM_DATA struct Sprite gSprites[MAX_SPRITES + 1] = {0};
-EWRAM_DATA static u8 sSpriteOrder[MAX_SPRITES] = {0};
+// Bit per sprite that may be in use. CreateSpriteAt, CloneSpriteAt and
+// DestroySprite keep it a superset of the sprites with inUse set, so the
+// per-frame loops only visit those.
+EWRAM_DATA static u32 sActiveSprites[MAX_SPRITES / 32] = {0};
 EWRAM_DATA static bool8 sShouldProcessSpriteCopyRequests = 0;
 EWRAM_DATA static u8 sSpriteCopyRequestCount = 0;
 EWRAM_DATA static struct SpriteCopyRequest sSpriteCopyRequests[MAX_SPRITES] = {0};
@@ -273,6 +276,25 @@ EWRAM_DATA s16 gSpriteCoordOffsetY = 0;
 EWRAM_DATA struct OamMatrix gOamMatrices[OAM_MATRIX_COUNT] = {0};
 EWRAM_DATA bool8 gAffineAnimsDisabled = FALSE;
 
+STATIC_ASSERT(MAX_SPRITES % 32 == 0, ActiveSpritesFitInWords);
+
+#define SET_SPRITE_ACTIVE(n)   (sActiveSprites[(n) / 32] |= (1u << ((n) % 32)))
+#define CLEAR_SPRITE_ACTIVE(n) (sActiveSprites[(n) / 32] &= ~(1u << ((n) % 32)))
+
+// Returns the first sprite at or after index which may be in use, or MAX_SPRITES.
+static inline u32 GetNextActiveSprite(u32 index)
+{
+    while (index < MAX_SPRITES)
+    {
+        u32 bits = sActiveSprites[index / 32] >> (index % 32);
+        if (bits != 0)
+            return index + __builtin_ctz(bits);
+        index = (index | 31) + 1;
+    }
+
+    return MAX_SPRITES;
+}
+
 void ResetSpriteData(void)
 {
     ResetOamRange(0, 128);
@@ -291,7 +313,10 @@ void ResetSpriteData(void)
 void AnimateSprites(void)
 {
     u32 i;
-    for (i = 0; i < MAX_SPRITES; i++)
+
+    // Sprites created by a callback are visited in the same frame if their
+    // index is higher, same as when scanning every slot.
+    for (i = GetNextActiveSprite(0); i < MAX_SPRITES; i = GetNextActiveSprite(i + 1))
     {
         struct Sprite *sprite = &gSprites[i];
 
@@ -317,23 +342,18 @@ void BuildOamBuffer(void)
     // we can load it with a ldrb instead of having to mask out the
     // bottom 6 bits.
     u32 spritePriorities[MAX_SPRITES];
+    u32 scratch[MAX_SPRITES];
+    u32 *sorted;
     s32 toSort = 0;
-    u8 skippedSprites[MAX_SPRITES];
-    u32 skippedSpritesN = 0;
     u32 matrices = 0;
+    u32 index;
 
-    for (i = 0; i < MAX_SPRITES; i++)
+    for (index = GetNextActiveSprite(0); index < MAX_SPRITES; index = GetNextActiveSprite(index + 1))
     {
-        // Reuse existing sSpriteOrder because we expect the order to be
-        // relatively stable between frames.
-        u32 index = sSpriteOrder[i];
         struct Sprite *sprite = &gSprites[index];
         s32 y;
         if (!sprite->inUse || sprite->invisible)
-        {
-            skippedSprites[skippedSpritesN++] = index;
             continue;
-        }
 
         if (sprite->oam.affineMode & ST_OAM_AFFINE_ON_MASK)
             matrices |= 1 << sprite->oam.matrixNum;
@@ -373,19 +393,14 @@ void BuildOamBuffer(void)
             | (index << 0);
     }
 
-    SortSprites(spritePriorities, toSort);
-
-    for (i = 0; i < toSort; i++)
-        sSpriteOrder[i] = spritePriorities[i] & 0xFF;
-    for (i = 0; i < skippedSpritesN; i++)
-        sSpriteOrder[toSort + i] = skippedSprites[i];
+    sorted = SortSprites(spritePriorities, scratch, toSort);
 
     oamLoadDisabled = gMain.oamLoadDisabled;
     gMain.oamLoadDisabled = TRUE;
 
     for (i = 0, oamIndex = 0; i < toSort; i++)
     {
-        if (AddSpriteToOamBuffer(&gSprites[spritePriorities[i] & 0xFF], &oamIndex))
+        if (AddSpriteToOamBuffer(&gSprites[sorted[i] & 0xFF], &oamIndex))
             break;
     }
 
@@ -426,9 +441,80 @@ static inline void InsertionSort(u32 *spritePriorities, s32 n)
     }
 }
 
-static void SortSprites(u32 *spritePriorities, s32 n)
+// Digits of the radix sort, covering { priority:2, subpriority:8, y:9 }. The
+// keys arrive in index order, so the index byte needs no pass of its own.
+#define SORT_DIGIT_0_SHIFT 13
+#define SORT_DIGIT_1_SHIFT 19
+#define SORT_DIGIT_2_SHIFT 26
+#define SORT_DIGIT_0_COUNT (1 << (SORT_DIGIT_1_SHIFT - SORT_DIGIT_0_SHIFT))
+#define SORT_DIGIT_1_COUNT (1 << (SORT_DIGIT_2_SHIFT - SORT_DIGIT_1_SHIFT))
+#define SORT_DIGIT_2_COUNT (1 << (32 - SORT_DIGIT_2_SHIFT))
+
+// Below this many sprites insertion sort beats clearing the buckets.
+#define RADIX_SORT_MIN_SPRITES 12
+
+static void RadixSortPass(const u32 *src, u32 *dest, s32 n, u8 *counts, u32 numCounts, u32 shift)
 {
-    InsertionSort(spritePriorities, n);
+    s32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < numCounts; i++)
+    {
+        u32 count = counts[i];
+        counts[i] = sum;
+        sum += count;
+    }
+
+    for (i = 0; i < n; i++)
+        dest[counts[(src[i] >> shift) & (numCounts - 1)]++] = src[i];
+}
+
+// Sorts n keys whose index bytes are ascending. Returns whichever of
+// spritePriorities and scratch holds the result.
+static u32 *SortSprites(u32 *spritePriorities, u32 *scratch, s32 n)
+{
+    u8 counts0[SORT_DIGIT_0_COUNT];
+    u8 counts1[SORT_DIGIT_1_COUNT];
+    u8 counts2[SORT_DIGIT_2_COUNT];
+    u32 *src = spritePriorities, *dest = scratch, *temp;
+    s32 i;
+
+    if (n < RADIX_SORT_MIN_SPRITES)
+    {
+        InsertionSort(spritePriorities, n);
+        return spritePriorities;
+    }
+
+    memset(counts0, 0, sizeof(counts0));
+    memset(counts1, 0, sizeof(counts1));
+    memset(counts2, 0, sizeof(counts2));
+    for (i = 0; i < n; i++)
+    {
+        u32 key = spritePriorities[i];
+        counts0[(key >> SORT_DIGIT_0_SHIFT) & (SORT_DIGIT_0_COUNT - 1)]++;
+        counts1[(key >> SORT_DIGIT_1_SHIFT) & (SORT_DIGIT_1_COUNT - 1)]++;
+        counts2[key >> SORT_DIGIT_2_SHIFT]++;
+    }
+
+    // Skip digits that are the same for every sprite, which is common for the
+    // priority and subpriority bits.
+    if (counts0[(src[0] >> SORT_DIGIT_0_SHIFT) & (SORT_DIGIT_0_COUNT - 1)] != n)
+    {
+        RadixSortPass(src, dest, n, counts0, SORT_DIGIT_0_COUNT, SORT_DIGIT_0_SHIFT);
+        SWAP(src, dest, temp);
+    }
+    if (counts1[(src[0] >> SORT_DIGIT_1_SHIFT) & (SORT_DIGIT_1_COUNT - 1)] != n)
+    {
+        RadixSortPass(src, dest, n, counts1, SORT_DIGIT_1_COUNT, SORT_DIGIT_1_SHIFT);
+        SWAP(src, dest, temp);
+    }
+    if (counts2[src[0] >> SORT_DIGIT_2_SHIFT] != n)
+    {
+        RadixSortPass(src, dest, n, counts2, SORT_DIGIT_2_COUNT, SORT_DIGIT_2_SHIFT);
+        SWAP(src, dest, temp);
+    }
+
+    return src;
 }
 
 u32 CreateSprite(const struct SpriteTemplate *template, s16 x, s16 y, u32 subpriority)
@@ -517,9 +603,19 @@ u32 CreateSpriteAt(u32 index, const struct SpriteTemplate *template, s16 x, s16
     if (template->paletteTag != TAG_NONE)
         sprite->oam.paletteNum = IndexOfSpritePaletteTag(template->paletteTag);
 
+    SET_SPRITE_ACTIVE(index);
     return index;
 }
 
+// For code that duplicates a sprite into another slot instead of creating it
+// from a template.
+void CloneSpriteAt(u32 index, const struct Sprite *sprite)
+{
+    gSprites[index] = *sprite;
+    if (gSprites[index].inUse)
+        SET_SPRITE_ACTIVE(index);
+}
+
 u32 CreateSpriteAndAnimate(const struct SpriteTemplate *template, s16 x, s16 y, u32 subpriority)
 {
     u32 i;
@@ -549,6 +645,11 @@ u32 CreateSpriteAndAnimate(const struct SpriteTemplate *template, s16 x, s16 y,
 
 void DestroySprite(struct Sprite *sprite)
 {
+    u32 index = sprite - gSprites;
+
+    if (index < MAX_SPRITES)
+        CLEAR_SPRITE_ACTIVE(index);
+
     if (sprite->inUse)
     {
         if (!sprite->usingSheet)
@@ -783,6 +884,13 @@ void CopyToSprites(u8 *src)
         src++;
         dest++;
     }
+
+    memset(sActiveSprites, 0, sizeof(sActiveSprites));
+    for (i = 0; i < MAX_SPRITES; i++)
+    {
+        if (gSprites[i].inUse)
+            SET_SPRITE_ACTIVE(i);
+    }
 }
 
 void ResetAllSprites(void)
@@ -790,12 +898,10 @@ void ResetAllSprites(void)
     u32 i;
 
     for (i = 0; i < MAX_SPRITES; i++)
-    {
         ResetSprite(&gSprites[i]);
-        sSpriteOrder[i] = i;
-    }
 
     ResetSprite(&gSprites[i]);
+    memset(sActiveSprites, 0, sizeof(sActiveSprites));
 }
 
 void FreeSpriteTiles(struct Sprite *sprite)
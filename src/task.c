@@ -3,8 +3,31 @@
 
 COMMON_DATA struct Task gTasks[NUM_TASKS] = {0};
 
+// The tasks form a linked list sorted by priority. The head, the set of active tasks and
+// the last task of every priority are tracked, so nothing has to scan gTasks.
+#define NUM_TASK_PRIORITIES 256
+
+static EWRAM_DATA u16 sActiveTasks = 0; // Bit per task id
+static EWRAM_DATA u8 sFirstTaskId = 0; // Only meaningful while sActiveTasks != 0
+static EWRAM_DATA u32 sUsedPriorities[NUM_TASK_PRIORITIES / 32] = {0};
+static EWRAM_DATA u8 sLastTaskOfPriority[NUM_TASK_PRIORITIES] = {0};
+
+STATIC_ASSERT(NUM_TASKS <= 16, TaskBitsFitInActiveTasks);
+
+#if DEBUG_TASK_CYCLES && TESTING
+#error "DEBUG_TASK_CYCLES cannot be used in tests, which need Timer 1 for the flash timer."
+#endif
+
+#if DEBUG_TASK_CYCLES && !defined(NDEBUG)
+#define PROFILE_TASKS TRUE
+#else
+#define PROFILE_TASKS FALSE
+#endif
+
 static void InsertTask(u8 newTaskId);
-static u8 FindFirstActiveTask(void);
+#if PROFILE_TASKS
+static void RunTasksProfiled(void);
+#endif
 
 void ResetTasks(void)
 {
@@ -22,73 +45,104 @@ void ResetTasks(void)
 
     gTasks[0].prev = HEAD_SENTINEL;
     gTasks[NUM_TASKS - 1].next = TAIL_SENTINEL;
+
+    sActiveTasks = 0;
+    memset(sUsedPriorities, 0, sizeof(sUsedPriorities));
 }
 
 u8 CreateTask(TaskFunc func, u8 priority)
 {
     u8 i;
 
-    for (i = 0; i < NUM_TASKS; i++)
+    if (sActiveTasks != (1u << NUM_TASKS) - 1)
     {
-        if (!gTasks[i].isActive)
-        {
-            gTasks[i].func = func;
-            gTasks[i].priority = priority;
-            InsertTask(i);
-            memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
-            gTasks[i].isActive = TRUE;
-            return i;
-        }
+        // Lowest free task id
+        i = __builtin_ctz(~sActiveTasks);
+        gTasks[i].func = func;
+        gTasks[i].priority = priority;
+        InsertTask(i);
+        memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
+        gTasks[i].isActive = TRUE;
+        sActiveTasks |= 1u << i;
+        return i;
     }
 
     return 0;
 }
 
+// Returns the highest priority value in use that is <= priority, or -1 if there is none.
+static s32 FindPriorityAtOrBefore(u32 priority)
+{
+    s32 word = priority / 32;
+    u32 bits = sUsedPriorities[word] & (0xFFFFFFFF >> (31 - priority % 32));
+
+    while (bits == 0)
+    {
+        if (--word < 0)
+            return -1;
+        bits = sUsedPriorities[word];
+    }
+
+    return word * 32 + 31 - __builtin_clz(bits);
+}
+
 static void InsertTask(u8 newTaskId)
 {
-    u8 taskId = FindFirstActiveTask();
+    u32 priority = gTasks[newTaskId].priority;
+    s32 prevPriority;
 
-    if (taskId == NUM_TASKS)
+    if (sActiveTasks == 0)
     {
         // The new task is the only task.
         gTasks[newTaskId].prev = HEAD_SENTINEL;
         gTasks[newTaskId].next = TAIL_SENTINEL;
-        return;
+        sFirstTaskId = newTaskId;
     }
-
-    while (1)
+    else if ((prevPriority = FindPriorityAtOrBefore(priority)) < 0)
     {
-        if (gTasks[newTaskId].priority < gTasks[taskId].priority)
-        {
-            // We've found a task with a higher priority value,
-            // so we insert the new task before it.
-            gTasks[newTaskId].prev = gTasks[taskId].prev;
-            gTasks[newTaskId].next = taskId;
-            if (gTasks[taskId].prev != HEAD_SENTINEL)
-                gTasks[gTasks[taskId].prev].next = newTaskId;
-            gTasks[taskId].prev = newTaskId;
-            return;
-        }
-        if (gTasks[taskId].next == TAIL_SENTINEL)
-        {
-            // We've reached the end.
-            gTasks[newTaskId].prev = taskId;
-            gTasks[newTaskId].next = gTasks[taskId].next;
-            gTasks[taskId].next = newTaskId;
-            return;
-        }
-        taskId = gTasks[taskId].next;
+        // Every task has a higher priority value, so the new task becomes the head.
+        gTasks[newTaskId].prev = HEAD_SENTINEL;
+        gTasks[newTaskId].next = sFirstTaskId;
+        gTasks[sFirstTaskId].prev = newTaskId;
+        sFirstTaskId = newTaskId;
     }
+    else
+    {
+        // Insert after the last task whose priority value isn't higher.
+        u8 taskId = sLastTaskOfPriority[prevPriority];
+
+        gTasks[newTaskId].prev = taskId;
+        gTasks[newTaskId].next = gTasks[taskId].next;
+        if (gTasks[taskId].next != TAIL_SENTINEL)
+            gTasks[gTasks[taskId].next].prev = newTaskId;
+        gTasks[taskId].next = newTaskId;
+    }
+
+    sLastTaskOfPriority[priority] = newTaskId;
+    sUsedPriorities[priority / 32] |= 1u << (priority % 32);
 }
 
 void DestroyTask(u8 taskId)
 {
     if (gTasks[taskId].isActive)
     {
+        u32 priority = gTasks[taskId].priority;
+
         gTasks[taskId].isActive = FALSE;
+        sActiveTasks &= ~(1u << taskId);
 
+        if (sLastTaskOfPriority[priority] == taskId)
+        {
+            if (gTasks[taskId].prev != HEAD_SENTINEL && gTasks[gTasks[taskId].prev].priority == priority)
+                sLastTaskOfPriority[priority] = gTasks[taskId].prev;
+            else
+                sUsedPriorities[priority / 32] &= ~(1u << (priority % 32));
+        }
+
+        // The destroyed task keeps its own links, so RunTasks can still move on from it.
         if (gTasks[taskId].prev == HEAD_SENTINEL)
         {
+            sFirstTaskId = gTasks[taskId].next;
             if (gTasks[taskId].next != TAIL_SENTINEL)
                 gTasks[gTasks[taskId].next].prev = HEAD_SENTINEL;
         }
@@ -109,10 +163,16 @@ void DestroyTask(u8 taskId)
 
 void RunTasks(void)
 {
-    u8 taskId = FindFirstActiveTask();
+    u8 taskId;
 
-    if (taskId != NUM_TASKS)
+#if PROFILE_TASKS
+    RunTasksProfiled();
+    return;
+#endif
+
+    if (sActiveTasks != 0)
     {
+        taskId = sFirstTaskId;
         do
         {
             gTasks[taskId].func(taskId);
@@ -121,17 +181,107 @@ void RunTasks(void)
     }
 }
 
-static u8 FindFirstActiveTask(void)
+#if PROFILE_TASKS
+
+#define NUM_PROFILED_TASK_FUNCS 32
+#define NUM_PRINTED_TASK_FUNCS  5
+
+struct TaskFuncCycles
 {
-    u8 taskId;
+    TaskFunc func;
+    u32 frameCycles;
+    u32 peakCycles;
+    u32 totalCycles;
+};
 
-    for (taskId = 0; taskId < NUM_TASKS; taskId++)
-        if (gTasks[taskId].isActive == TRUE && gTasks[taskId].prev == HEAD_SENTINEL)
+static EWRAM_DATA struct TaskFuncCycles sTaskFuncCycles[NUM_PROFILED_TASK_FUNCS] = {0};
+static EWRAM_DATA u16 sProfiledFrames = 0;
+
+static struct TaskFuncCycles *GetTaskFuncCycles(TaskFunc func)
+{
+    u32 i;
+
+    for (i = 0; i < NUM_PROFILED_TASK_FUNCS; i++)
+    {
+        if (sTaskFuncCycles[i].func == func || sTaskFuncCycles[i].func == NULL)
+        {
+            sTaskFuncCycles[i].func = func;
+            return &sTaskFuncCycles[i];
+        }
+    }
+
+    return NULL; // Table is full, this function isn't counted until the next report
+}
+
+static void PrintTaskCycles(void)
+{
+    u32 i, j;
+
+    DebugPrintf("Task cycles over %d frames:", sProfiledFrames);
+    for (i = 0; i < NUM_PRINTED_TASK_FUNCS; i++)
+    {
+        struct TaskFuncCycles *worst = NULL;
+
+        for (j = 0; j < NUM_PROFILED_TASK_FUNCS; j++)
+        {
+            if (sTaskFuncCycles[j].func != NULL && (worst == NULL || sTaskFuncCycles[j].peakCycles > worst->peakCycles))
+                worst = &sTaskFuncCycles[j];
+        }
+        if (worst == NULL)
             break;
 
-    return taskId;
+        DebugPrintf("  %x: peak %d/frame, avg %d/frame", (u32)worst->func, worst->peakCycles, worst->totalCycles / sProfiledFrames);
+        worst->func = NULL;
+    }
+
+    memset(sTaskFuncCycles, 0, sizeof(sTaskFuncCycles));
+    sProfiledFrames = 0;
 }
 
+// Same as RunTasks, but counts the cycles of every task function. Timer 1 is only
+// used while seeding the RNG, so unlike CycleCountStart it does not take the
+// timers used for flash timeouts and by tasks that time themselves. Counting in
+// 64-cycle ticks keeps a 16-bit timer from wrapping within a frame.
+static void RunTasksProfiled(void)
+{
+    u8 taskId;
+    u32 i;
+    u16 start, end;
+
+    REG_TM1CNT_H = 0;
+    REG_TM1CNT_L = 0;
+    REG_TM1CNT_H = TIMER_ENABLE | TIMER_64CLK;
+    if (sActiveTasks != 0)
+    {
+        taskId = sFirstTaskId;
+        do
+        {
+            struct TaskFuncCycles *entry = GetTaskFuncCycles(gTasks[taskId].func);
+
+            start = REG_TM1CNT_L;
+            gTasks[taskId].func(taskId);
+            end = REG_TM1CNT_L;
+            if (entry != NULL)
+                entry->frameCycles += (u16)(end - start) * 64;
+            taskId = gTasks[taskId].next;
+        } while (taskId != TAIL_SENTINEL);
+    }
+    REG_TM1CNT_H = 0;
+
+    for (i = 0; i < NUM_PROFILED_TASK_FUNCS && sTaskFuncCycles[i].func != NULL; i++)
+    {
+        if (sTaskFuncCycles[i].frameCycles > sTaskFuncCycles[i].peakCycles)
+            sTaskFuncCycles[i].peakCycles = sTaskFuncCycles[i].frameCycles;
+        sTaskFuncCycles[i].totalCycles += sTaskFuncCycles[i].frameCycles;
+        sTaskFuncCycles[i].frameCycles = 0;
+    }
+
+    if (++sProfiledFrames >= DEBUG_TASK_CYCLES_FRAMES)
+        PrintTaskCycles();
+}
+
+#endif // PROFILE_TASKS
+
 void TaskDummy(u8 taskId)
 {
 }
@@ -9,3 +9,6 @@ const bool8 gTestRunnerEnabled = FALSE;
 // animations and messages play, which helps when debugging a test.
 const bool8 gTestRunnerHeadless = FALSE;
 const bool8 gTestRunnerSkipIsFail = FALSE;
+
+// Patched by `make check PROFILE=1` to sample the running functions.
+const bool8 gTestRunnerProfile = FALSE;
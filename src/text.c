@@ -58,10 +58,23 @@ static u32 GetGlyphWidth_SmallNarrower(u16, bool32);
 static u32 GetGlyphWidth_ShortNarrow(u16, bool32);
 static u32 GetGlyphWidth_Short(u16, bool32);
 static void SpriteCB_TextCursor(struct Sprite *sprite);
+static void MarkTextPrinterDirty(struct TextPrinter *textPrinter, s32 x, s32 y, s32 width, s32 height);
+static void MarkTextPrinterWindowDirty(struct TextPrinter *textPrinter);
 
 static EWRAM_DATA struct TextPrinter sTempTextPrinter = {0};
 static EWRAM_DATA struct TextPrinter sTextPrinters[WINDOWS_MAX] = {0};
 
+// The span of each window's tiles that its text printer has drawn to
+// since it was last uploaded. RunTextPrinters uploads the spans of the
+// windows that printed once all of the printers have run.
+static EWRAM_DATA struct {
+    u16 firstTile;
+    u16 lastTile;
+    bool8 print;
+} sTextPrinterDirtyTiles[WINDOWS_MAX] = {0};
+// Whether the current print was tracked, otherwise the whole window is uploaded.
+static EWRAM_DATA bool8 sTextPrinterMarkedDirty = FALSE;
+
 static u16 sFontHalfRowLookupTable[0x51];
 static u16 sLastTextBgColor;
 static u16 sLastTextFgColor;
@@ -365,6 +378,11 @@ bool32 AddTextPrinter(struct TextPrinterTemplate *printerTemplate, u8 speed, voi
     {
         --sTempTextPrinter.textSpeed;
         sTextPrinters[printerTemplate->windowId] = sTempTextPrinter;
+        // The window may have been drawn to since it was last uploaded.
+        sTextPrinterDirtyTiles[printerTemplate->windowId].firstTile = UINT16_MAX;
+        sTextPrinterDirtyTiles[printerTemplate->windowId].lastTile = 0;
+        sTextPrinterDirtyTiles[printerTemplate->windowId].print = FALSE;
+        MarkTextPrinterWindowDirty(&sTempTextPrinter);
     }
     else
     {
@@ -386,6 +404,35 @@ bool32 AddTextPrinter(struct TextPrinterTemplate *printerTemplate, u8 speed, voi
     return TRUE;
 }
 
+static void MarkTextPrinterDirty(struct TextPrinter *textPrinter, s32 x, s32 y, s32 width, s32 height)
+{
+    u32 windowId = textPrinter->printerTemplate.windowId;
+    const struct WindowTemplate *template = &gWindows[windowId].window;
+    u32 firstTile, lastTile;
+
+    sTextPrinterMarkedDirty = TRUE;
+
+    if (x + width > template->width * 8)
+        width = template->width * 8 - x;
+    if (y + height > template->height * 8)
+        height = template->height * 8 - y;
+    if (width <= 0 || height <= 0)
+        return;
+
+    firstTile = (y / 8) * template->width + (x / 8);
+    lastTile = ((y + height - 1) / 8) * template->width + ((x + width - 1) / 8);
+    if (sTextPrinterDirtyTiles[windowId].firstTile > firstTile)
+        sTextPrinterDirtyTiles[windowId].firstTile = firstTile;
+    if (sTextPrinterDirtyTiles[windowId].lastTile < lastTile)
+        sTextPrinterDirtyTiles[windowId].lastTile = lastTile;
+}
+
+static void MarkTextPrinterWindowDirty(struct TextPrinter *textPrinter)
+{
+    const struct WindowTemplate *template = &gWindows[textPrinter->printerTemplate.windowId].window;
+    MarkTextPrinterDirty(textPrinter, 0, 0, template->width * 8, template->height * 8);
+}
+
 void RunTextPrinters(void)
 {
     int i;
@@ -394,11 +441,15 @@ void RunTextPrinters(void)
     {
         if (sTextPrinters[i].active)
         {
-            u16 renderCmd = RenderFont(&sTextPrinters[i]);
+            u16 renderCmd;
+            sTextPrinterMarkedDirty = FALSE;
+            renderCmd = RenderFont(&sTextPrinters[i]);
             switch (renderCmd)
             {
             case RENDER_PRINT:
-                CopyWindowToVram(sTextPrinters[i].printerTemplate.windowId, COPYWIN_GFX);
+                if (!sTextPrinterMarkedDirty)
+                    MarkTextPrinterWindowDirty(&sTextPrinters[i]);
+                sTextPrinterDirtyTiles[i].print = TRUE;
             case RENDER_UPDATE:
                 if (sTextPrinters[i].callback != NULL)
                     sTextPrinters[i].callback(&sTextPrinters[i].printerTemplate, renderCmd);
@@ -409,6 +460,18 @@ void RunTextPrinters(void)
             }
         }
     }
+
+    for (i = 0; i < WINDOWS_MAX; ++i)
+    {
+        if (sTextPrinterDirtyTiles[i].print)
+        {
+            if (sTextPrinterDirtyTiles[i].firstTile <= sTextPrinterDirtyTiles[i].lastTile)
+                CopyWindowTilesToVram(i, sTextPrinterDirtyTiles[i].firstTile, sTextPrinterDirtyTiles[i].lastTile - sTextPrinterDirtyTiles[i].firstTile + 1);
+            sTextPrinterDirtyTiles[i].firstTile = UINT16_MAX;
+            sTextPrinterDirtyTiles[i].lastTile = 0;
+            sTextPrinterDirtyTiles[i].print = FALSE;
+        }
+    }
 }
 
 bool32 IsTextPrinterActive(u8 id)
@@ -1185,6 +1248,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
                 return RENDER_REPEAT;
             case EXT_CTRL_CODE_FILL_WINDOW:
                 FillWindowPixelBuffer(textPrinter->printerTemplate.windowId, PIXEL_FILL(textPrinter->printerTemplate.bgColor));
+                MarkTextPrinterWindowDirty(textPrinter);
                 return RENDER_REPEAT;
             case EXT_CTRL_CODE_PAUSE_MUSIC:
                 m4aMPlayStop(&gMPlayInfo_BGM);
@@ -1198,6 +1262,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
                 if (width > 0)
                 {
                     ClearTextSpan(textPrinter, width);
+                    MarkTextPrinterDirty(textPrinter, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY, width, gCurGlyph.height);
                     textPrinter->printerTemplate.currentX += width;
                     return RENDER_PRINT;
                 }
@@ -1215,6 +1280,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
                     if (width > 0)
                     {
                         ClearTextSpan(textPrinter, width);
+                        MarkTextPrinterDirty(textPrinter, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY, width, gCurGlyph.height);
                         textPrinter->printerTemplate.currentX += width;
                         return RENDER_PRINT;
                     }
@@ -1246,6 +1312,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
         case CHAR_KEYPAD_ICON:
             currChar = *textPrinter->printerTemplate.currentChar++;
             gCurGlyph.width = DrawKeypadIcon(textPrinter->printerTemplate.windowId, currChar, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY);
+            MarkTextPrinterDirty(textPrinter, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY, gCurGlyph.width, GetKeypadIconHeight(currChar));
             textPrinter->printerTemplate.currentX += gCurGlyph.width + textPrinter->printerTemplate.letterSpacing;
             return RENDER_PRINT;
         case EOS:
@@ -1293,6 +1360,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
         }
 
         CopyGlyphToWindow(textPrinter);
+        MarkTextPrinterDirty(textPrinter, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY, gCurGlyph.width, gCurGlyph.height);
 
         if (textPrinter->minLetterSpacing)
         {
@@ -1301,6 +1369,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
             if (width > 0)
             {
                 ClearTextSpan(textPrinter, width);
+                MarkTextPrinterDirty(textPrinter, textPrinter->printerTemplate.currentX, textPrinter->printerTemplate.currentY, width, gCurGlyph.height);
                 textPrinter->printerTemplate.currentX += width;
             }
         }
@@ -1320,6 +1389,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
         if (TextPrinterWaitWithDownArrow(textPrinter))
         {
             FillWindowPixelBuffer(textPrinter->printerTemplate.windowId, PIXEL_FILL(textPrinter->printerTemplate.bgColor));
+            MarkTextPrinterWindowDirty(textPrinter);
             textPrinter->printerTemplate.currentX = textPrinter->printerTemplate.x;
             textPrinter->printerTemplate.currentY = textPrinter->printerTemplate.y;
             textPrinter->state = RENDER_STATE_HANDLE_CHAR;
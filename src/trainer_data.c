@@ -0,0 +1,25 @@
+#include "global.h"
+#include "battle.h"
+#include "battle_transition.h"
+#include "data.h"
+#include "constants/abilities.h"
+#include "constants/battle_ai.h"
+#include "constants/items.h"
+#include "constants/moves.h"
+#include "constants/trainers.h"
+
+// Kept out of data.c so that editing a .party file only rebuilds this object.
+
+#include "data/trainer_parties.h"
+
+const struct Trainer gTrainers[DIFFICULTY_COUNT][TRAINERS_COUNT] =
+{
+#include "data/trainers.h"
+};
+
+#include "data/partner_parties.h"
+
+const struct Trainer gBattlePartners[DIFFICULTY_COUNT][PARTNER_COUNT] =
+{
+#include "data/battle_partners.h"
+};
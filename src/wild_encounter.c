@@ -249,36 +249,52 @@ static u8 ChooseWildMonLevel(const struct WildPokemon *wildPokemon, u8 wildMonIn
     }
 }
 
-u16 GetCurrentMapWildMonHeaderId(void)
+u16 GetWildMonHeaderIdForMap(u32 mapGroup, u32 mapNum)
 {
-    u16 i;
+    u32 index;
 
-    for (i = 0; ; i++)
-    {
-        const struct WildPokemonHeader * wildHeader = &gWildMonHeaders[i];
-        if (wildHeader->mapGroup == MAP_GROUP(MAP_UNDEFINED))
-            break;
+    if (mapGroup >= ARRAY_COUNT(sWildMonHeaderMapOffsets) - 1)
+        return HEADER_NONE;
 
-        if (gWildMonHeaders[i].mapGroup == gSaveBlock1Ptr->location.mapGroup &&
-            gWildMonHeaders[i].mapNum == gSaveBlock1Ptr->location.mapNum)
-        {
-            if (gSaveBlock1Ptr->location.mapGroup == MAP_GROUP(MAP_SIX_ISLAND_ALTERING_CAVE) &&
-                gSaveBlock1Ptr->location.mapNum == MAP_NUM(MAP_SIX_ISLAND_ALTERING_CAVE))
-            {
-                u16 alteringCaveId = VarGet(VAR_ALTERING_CAVE_WILD_SET);
-                if (alteringCaveId >= NUM_ALTERING_CAVE_TABLES)
-                    alteringCaveId = 0;
+    index = sWildMonHeaderMapOffsets[mapGroup] + mapNum;
+    if (index >= sWildMonHeaderMapOffsets[mapGroup + 1])
+        return HEADER_NONE;
 
-                i += alteringCaveId;
-            }
+    return sWildMonHeaderIdsByMap[index];
+}
 
-            if (!UnlockedTanobyOrAreNotInTanoby())
-                break;
-            return i;
-        }
+// Whether the species is in any of the header's encounter tables, for any season and time of day.
+bool32 CanSpeciesBeInWildMonHeader(u32 species, u32 headerId)
+{
+    u32 setId;
+
+    if (species >= NUM_SPECIES || headerId / 32 >= WILD_MON_HEADER_SET_WORDS)
+        return FALSE;
+
+    setId = sWildSpeciesHeaderSetIds[species];
+    return (sWildSpeciesHeaderSets[setId][headerId / 32] & (1u << (headerId % 32))) != 0;
+}
+
+u16 GetCurrentMapWildMonHeaderId(void)
+{
+    u16 i = GetWildMonHeaderIdForMap(gSaveBlock1Ptr->location.mapGroup, gSaveBlock1Ptr->location.mapNum);
+
+    if (i == HEADER_NONE)
+        return HEADER_NONE;
+
+    if (gSaveBlock1Ptr->location.mapGroup == MAP_GROUP(MAP_SIX_ISLAND_ALTERING_CAVE) &&
+        gSaveBlock1Ptr->location.mapNum == MAP_NUM(MAP_SIX_ISLAND_ALTERING_CAVE))
+    {
+        u16 alteringCaveId = VarGet(VAR_ALTERING_CAVE_WILD_SET);
+        if (alteringCaveId >= NUM_ALTERING_CAVE_TABLES)
+            alteringCaveId = 0;
+
+        i += alteringCaveId;
     }
 
-    return HEADER_NONE;
+    if (!UnlockedTanobyOrAreNotInTanoby())
+        return HEADER_NONE;
+    return i;
 }
 
 enum EncounterFallbacks
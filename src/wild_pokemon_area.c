@@ -262,6 +262,10 @@ static bool32 IsSpeciesOnMap(const struct WildPokemonHeader * data, u32 headerId
 {
     enum Season season;
     enum TimeOfDay timeOfDay;
+
+    if (!CanSpeciesBeInWildMonHeader(species, headerId))
+        return FALSE;
+
     GetSeasonAndTimeOfDayForEncounters(headerId, WILD_AREA_LAND, &season, &timeOfDay);
     if (IsSpeciesInEncounterTable(data->encounterTypes[season][timeOfDay].landMonsInfo, species, LAND_WILD_COUNT))
         return TRUE;
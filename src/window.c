@@ -317,6 +317,15 @@ void CopyWindowRectToVram(u32 windowId, u32 mode, u32 x, u32 y, u32 w, u32 h)
     }
 }
 
+// Uploads numTiles of the window's tiles from firstTile onwards.
+void CopyWindowTilesToVram(u32 windowId, u32 firstTile, u32 numTiles)
+{
+    struct Window *window = &gWindows[windowId];
+
+    if (numTiles != 0)
+        LoadBgTiles(window->window.bg, window->tileData + (firstTile * 32), numTiles * 32, window->window.baseBlock + firstTile);
+}
+
 void PutWindowTilemap(u32 windowId)
 {
     struct Window windowLocal = gWindows[windowId];
@@ -310,3 +310,26 @@ SINGLE_BATTLE_TEST("Neutralizing Gas exiting the field does not activate Imposte
         NOT ABILITY_POPUP(player, ABILITY_IMPOSTER);
     }
 }
+
+DOUBLE_BATTLE_TEST("Neutralizing Gas switched in mid-turn suppresses abilities for moves used later in the turn")
+{
+    GIVEN {
+        ASSUME(GetMoveType(MOVE_MUD_SLAP) == TYPE_GROUND);
+        ASSUME(GetMoveEffect(MOVE_U_TURN) == EFFECT_HIT_ESCAPE);
+        PLAYER(SPECIES_WOBBUFFET) { Speed(3); }
+        PLAYER(SPECIES_WYNAUT) { Speed(2); }
+        PLAYER(SPECIES_KOFFING) { Ability(ABILITY_NEUTRALIZING_GAS); Speed(3); }
+        OPPONENT(SPECIES_FLYGON) { Ability(ABILITY_LEVITATE); Speed(1); }
+        OPPONENT(SPECIES_WOBBUFFET) { Speed(1); }
+    } WHEN {
+        TURN { MOVE(playerRight, MOVE_MUD_SLAP, target: opponentLeft); }
+        TURN { MOVE(playerLeft, MOVE_U_TURN, target: opponentRight); SEND_OUT(playerLeft, 2); MOVE(playerRight, MOVE_MUD_SLAP, target: opponentLeft); }
+    } SCENE {
+        ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_U_TURN, playerLeft);
+        ABILITY_POPUP(playerLeft, ABILITY_NEUTRALIZING_GAS);
+        NOT ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_MUD_SLAP, playerRight);
+        HP_BAR(opponentLeft);
+    }
+}
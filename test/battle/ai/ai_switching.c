@@ -267,6 +267,26 @@ AI_SINGLE_BATTLE_TEST("AI_FLAG_SMART_MON_CHOICES: AI will not switch in a Pokemo
     }
 }
 
+AI_SINGLE_BATTLE_TEST("AI sees status changes from earlier in the turn when replacing a fainted Pokemon")
+{
+    u32 move, expectedIndex;
+
+    PARAMETRIZE { move = MOVE_CELEBRATE; expectedIndex = 1; }
+    PARAMETRIZE { move = MOVE_MAGNET_RISE; expectedIndex = 2; } // Earthquake damage calculated at the start of the turn is stale
+
+    GIVEN {
+        ASSUME(GetMoveEffect(MOVE_MAGNET_RISE) == EFFECT_MAGNET_RISE);
+        ASSUME(GetMoveEffect(MOVE_HEALING_WISH) == EFFECT_HEALING_WISH);
+        AI_FLAGS(AI_FLAG_CHECK_BAD_MOVE | AI_FLAG_CHECK_VIABILITY | AI_FLAG_TRY_TO_FAINT);
+        PLAYER(SPECIES_WOBBUFFET) { Speed(100); Moves(MOVE_MAGNET_RISE, MOVE_CELEBRATE); }
+        OPPONENT(SPECIES_WYNAUT) { Speed(1); Moves(MOVE_HEALING_WISH); }
+        OPPONENT(SPECIES_DUGTRIO) { Speed(1); Moves(MOVE_EARTHQUAKE); }
+        OPPONENT(SPECIES_RATTATA) { Speed(1); Moves(MOVE_SCRATCH); }
+    } WHEN {
+        TURN { MOVE(player, move); EXPECT_MOVE(opponent, MOVE_HEALING_WISH); EXPECT_SEND_OUT(opponent, expectedIndex); }
+    }
+}
+
 AI_SINGLE_BATTLE_TEST("AI_FLAG_SMART_MON_CHOICES: AI considers hazard damage when choosing which Pokemon to switch in")
 {
     u32 aiIsSmart = 0;
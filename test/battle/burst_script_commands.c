@@ -0,0 +1,46 @@
+#include "global.h"
+#include "test/battle.h"
+
+DOUBLE_BATTLE_TEST("Burst script commands give the same battle in fewer frames", u32 rngCalls, u32 startFrame, u32 frames, u32 traceEventsCount, struct TraceEvent traceEvents[MAX_TRACE_EVENTS])
+{
+    bool32 burst;
+
+    // The flag is only cleared after the last parameter.
+    PARAMETRIZE { burst = FALSE; }
+    PARAMETRIZE { burst = TRUE; }
+    GIVEN {
+        if (burst)
+            FLAG_SET(B_FLAG_BURST_SCRIPT_COMMANDS);
+        results[i].startFrame = gMain.vblankCounter1;
+        PLAYER(SPECIES_WYNAUT) { HP(100); Speed(1); }
+        PLAYER(SPECIES_EKANS) { HP(100); Ability(ABILITY_SHED_SKIN); Status1(STATUS1_BURN); Speed(2); }
+        OPPONENT(SPECIES_WYNAUT) { HP(100); Item(ITEM_LEFTOVERS); Speed(3); }
+        OPPONENT(SPECIES_WOBBUFFET) { HP(100); Item(ITEM_BLACK_SLUDGE); Speed(4); }
+    } WHEN {
+        TURN { MOVE(playerLeft, MOVE_GRASSY_TERRAIN); }
+    } SCENE {
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_GRASSY_TERRAIN, playerLeft);
+        MESSAGE("The opposing Wobbuffet is healed by the grassy terrain!");
+        HP_BAR(opponentRight);
+        HP_BAR(opponentRight);
+        MESSAGE("The opposing Wobbuffet was hurt by the Black Sludge!");
+        MESSAGE("The opposing Wynaut is healed by the grassy terrain!");
+        MESSAGE("The opposing Wynaut restored a little HP using its Leftovers!");
+        MESSAGE("Ekans is healed by the grassy terrain!");
+        MESSAGE("Ekans's Shed Skin cured its burn problem!");
+        MESSAGE("Wynaut is healed by the grassy terrain!");
+    } THEN {
+        results[i].rngCalls = gRngValue.ctr;
+        results[i].frames = gMain.vblankCounter1 - results[i].startFrame;
+        results[i].traceEventsCount = gBattleTestRunnerState->data.trial.traceEventsCount;
+        memcpy(results[i].traceEvents, gBattleTestRunnerState->data.trial.traceEvents, sizeof(results[i].traceEvents));
+    } FINALLY {
+        // Every tagged Random* call with its result and every message, in order.
+        EXPECT_GT(results[0].traceEventsCount, 0);
+        EXPECT_LE(results[0].traceEventsCount, MAX_TRACE_EVENTS);
+        EXPECT_EQ(results[0].traceEventsCount, results[1].traceEventsCount);
+        EXPECT_EQ(memcmp(results[0].traceEvents, results[1].traceEvents, sizeof(results[0].traceEvents)), 0);
+        EXPECT_EQ(results[0].rngCalls, results[1].rngCalls);
+        EXPECT_LT(results[1].frames, results[0].frames);
+    }
+}
@@ -136,3 +136,24 @@ SINGLE_BATTLE_TEST("Ability Shield protects against Skill Swap")
         }
     }
 }
+
+DOUBLE_BATTLE_TEST("Ability Shield stops protecting against Neutralizing Gas as soon as it is knocked off")
+{
+    GIVEN {
+        ASSUME(GetMoveType(MOVE_MUD_SLAP) == TYPE_GROUND);
+        ASSUME(GetMoveEffect(MOVE_KNOCK_OFF) == EFFECT_KNOCK_OFF);
+        PLAYER(SPECIES_KOFFING) { Ability(ABILITY_NEUTRALIZING_GAS); Speed(2); }
+        PLAYER(SPECIES_WYNAUT) { Speed(3); }
+        OPPONENT(SPECIES_FLYGON) { Ability(ABILITY_LEVITATE); Item(ITEM_ABILITY_SHIELD); Speed(1); }
+        OPPONENT(SPECIES_WOBBUFFET) { Speed(1); }
+    } WHEN {
+        TURN { MOVE(playerLeft, MOVE_MUD_SLAP, target: opponentLeft); }
+        TURN { MOVE(playerRight, MOVE_KNOCK_OFF, target: opponentLeft); MOVE(playerLeft, MOVE_MUD_SLAP, target: opponentLeft); }
+    } SCENE {
+        ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_KNOCK_OFF, playerRight);
+        NOT ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_MUD_SLAP, playerLeft);
+        HP_BAR(opponentLeft);
+    }
+}
@@ -42,3 +42,23 @@ SINGLE_BATTLE_TEST("Gastro Acid fails if target has a banned ability")
 
 TO_DO_BATTLE_TEST("Baton Pass passes Gastro Acid's effect");
 TO_DO_BATTLE_TEST("Baton Pass removes Gastro Acid if its ability cannot be surpressed");
+
+DOUBLE_BATTLE_TEST("Gastro Acid suppresses the target's ability for moves used later in the turn")
+{
+    GIVEN {
+        ASSUME(GetMoveType(MOVE_MUD_SLAP) == TYPE_GROUND);
+        PLAYER(SPECIES_WOBBUFFET) { Speed(2); }
+        PLAYER(SPECIES_WYNAUT) { Speed(3); }
+        OPPONENT(SPECIES_FLYGON) { Ability(ABILITY_LEVITATE); Speed(1); }
+        OPPONENT(SPECIES_WOBBUFFET) { Speed(1); }
+    } WHEN {
+        TURN { MOVE(playerLeft, MOVE_MUD_SLAP, target: opponentLeft); }
+        TURN { MOVE(playerRight, MOVE_GASTRO_ACID, target: opponentLeft); MOVE(playerLeft, MOVE_MUD_SLAP, target: opponentLeft); }
+    } SCENE {
+        ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_GASTRO_ACID, playerRight);
+        NOT ABILITY_POPUP(opponentLeft, ABILITY_LEVITATE);
+        ANIMATION(ANIM_TYPE_MOVE, MOVE_MUD_SLAP, playerLeft);
+        HP_BAR(opponentLeft);
+    }
+}
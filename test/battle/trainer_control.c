@@ -37,6 +37,8 @@ TEST("CreateNPCTrainerPartyForTrainer generates customized Pokémon")
     struct Pokemon *testParty = Alloc(6 * sizeof(struct Pokemon));
     u32 currTrainer = 0;
     u8 nickBuffer[20];
+    // Tera and Dynamax mons are recorded in gBattleStruct.
+    gBattleStruct = AllocZeroed(sizeof(*gBattleStruct));
     CreateNPCTrainerPartyFromTrainer(testParty, &sTestTrainers[GetTrainerDifficultyLevelTest(currTrainer)][currTrainer], TRUE, BATTLE_TYPE_TRAINER);
     EXPECT(IsMonShiny(&testParty[0]));
     EXPECT(!IsMonShiny(&testParty[1]));
@@ -106,6 +108,7 @@ TEST("CreateNPCTrainerPartyForTrainer generates customized Pokémon")
     EXPECT_EQ(GetMonData(&testParty[0], MON_DATA_DYNAMAX_LEVEL), 5);
     EXPECT_EQ(GetMonData(&testParty[1], MON_DATA_DYNAMAX_LEVEL), 10);
 
+    FREE_AND_SET_NULL(gBattleStruct);
     Free(testParty);
 }
 
@@ -113,8 +116,10 @@ TEST("CreateNPCTrainerPartyForTrainer generates different personalities for diff
 {
     enum DifficultyLevel difficulty = GetTrainerDifficultyLevelTest(0);
     struct Pokemon *testParty = Alloc(6 * sizeof(struct Pokemon));
+    gBattleStruct = AllocZeroed(sizeof(*gBattleStruct));
     CreateNPCTrainerPartyFromTrainer(testParty, &sTestTrainers[difficulty][0], TRUE, BATTLE_TYPE_TRAINER);
     EXPECT(testParty[0].box.personality != testParty[1].box.personality);
+    FREE_AND_SET_NULL(gBattleStruct);
     Free(testParty);
 }
 
@@ -0,0 +1,84 @@
+#include "global.h"
+#include "battle.h"
+#include "battle_ai_main.h"
+#include "battle_util.h"
+#include "battle_util2.h"
+#include "test/test.h"
+#include "config/ai.h"
+#include "constants/abilities.h"
+#include "constants/battle_ai.h"
+#include "constants/moves.h"
+
+static struct SimulatedDamage sExpectedDmg[MAX_BATTLERS_COUNT][MAX_BATTLERS_COUNT][MAX_MON_MOVES];
+
+// A double battle against a trainer, with enough simulations to take several frames.
+static void SetUpDoubleBattle(void)
+{
+    static const u16 moves[MAX_MON_MOVES] = { MOVE_TACKLE, MOVE_EMBER, MOVE_WATER_GUN, MOVE_THUNDER_SHOCK };
+    u32 battler, i;
+
+    gBattleTypeFlags = BATTLE_TYPE_TRAINER | BATTLE_TYPE_DOUBLE;
+    AllocateBattleResources();
+    memset(gBattleMons, 0, sizeof(gBattleMons));
+    memset(gDisableStructs, 0, sizeof(gDisableStructs));
+    memset(gProtectStructs, 0, sizeof(gProtectStructs));
+    memset(gStatuses3, 0, sizeof(gStatuses3));
+    memset(gStatuses4, 0, sizeof(gStatuses4));
+    memset(gLastMoves, 0, sizeof(gLastMoves));
+    gBattlersCount = MAX_BATTLERS_COUNT;
+    gAbsentBattlerFlags = 0;
+    gFieldStatuses = 0;
+    gBattleWeather = 0;
+    for (battler = 0; battler < MAX_BATTLERS_COUNT; battler++)
+    {
+        gBattlerPositions[battler] = battler;
+        gBattlerPartyIndexes[battler] = battler / 2;
+        gAiThinkingStruct->aiFlags[battler] = AI_FLAG_CHECK_BAD_MOVE | AI_FLAG_CHECK_VIABILITY | AI_FLAG_TRY_TO_FAINT;
+        gBattleMons[battler].species = SPECIES_WOBBUFFET;
+        gBattleMons[battler].ability = ABILITY_TELEPATHY;
+        gBattleMons[battler].level = 50;
+        gBattleMons[battler].hp = gBattleMons[battler].maxHP = 200;
+        gBattleMons[battler].attack = gBattleMons[battler].defense = 100;
+        gBattleMons[battler].spAttack = gBattleMons[battler].spDefense = 100;
+        gBattleMons[battler].speed = 100;
+        gBattleMons[battler].types[0] = gBattleMons[battler].types[1] = gBattleMons[battler].types[2] = TYPE_PSYCHIC;
+        for (i = 0; i < NUM_BATTLE_STATS; i++)
+            gBattleMons[battler].statStages[i] = DEFAULT_STAT_STAGE;
+        for (i = 0; i < MAX_MON_MOVES; i++)
+        {
+            gBattleMons[battler].moves[i] = moves[i];
+            gBattleMons[battler].pp[i] = 10;
+        }
+    }
+    InvalidateAbilityCache();
+}
+
+static void RunAiSimulations(void)
+{
+    SetAiLogicDataForTurn(gAiLogicData);
+    while (!ContinueAiLogicDataForTurn(gAiLogicData))
+        ;
+}
+
+TEST("AI damage simulations spread over frames start over if the battle changes in between")
+{
+    ASSUME(AI_DAMAGE_SIMULATIONS_PER_FRAME != 0);
+    SetUpDoubleBattle();
+
+    // What the simulations should end up with after the change.
+    gBattleMons[0].defense = 200;
+    RunAiSimulations();
+    memcpy(sExpectedDmg, gAiLogicData->simulatedDmg, sizeof(sExpectedDmg));
+    gBattleMons[0].defense = 100;
+    RunAiSimulations();
+    EXPECT_NE(memcmp(sExpectedDmg, gAiLogicData->simulatedDmg, sizeof(sExpectedDmg)), 0);
+
+    SetAiLogicDataForTurn(gAiLogicData);
+    EXPECT(!ContinueAiLogicDataForTurn(gAiLogicData));
+    gBattleMons[0].defense = 200;
+    while (!ContinueAiLogicDataForTurn(gAiLogicData))
+        ;
+    EXPECT_EQ(memcmp(sExpectedDmg, gAiLogicData->simulatedDmg, sizeof(sExpectedDmg)), 0);
+
+    FreeBattleResources();
+}
@@ -0,0 +1,229 @@
+#include "global.h"
+#include "battle.h"
+#include "battle_util.h"
+#include "item.h"
+#include "move.h"
+#include "test/test.h"
+#include "constants/abilities.h"
+#include "constants/items.h"
+#include "constants/moves.h"
+
+static u32 Old_GetBattlerAbility(u32 battler);
+static bool32 Old_IsNeutralizingGasOnField(void);
+static u32 Old_IsAbilityOnField(u32 ability);
+
+// Four battlers with abilities that Gastro Acid and Neutralizing Gas can suppress.
+static void SetUpBattlers(void)
+{
+    static const u16 abilities[MAX_BATTLERS_COUNT] = { ABILITY_LEVITATE, ABILITY_INTIMIDATE, ABILITY_KLUTZ, ABILITY_SHADOW_TAG };
+    u32 battler;
+
+    memset(gBattleMons, 0, sizeof(gBattleMons));
+    memset(gStatuses3, 0, sizeof(gStatuses3));
+    gBattlersCount = MAX_BATTLERS_COUNT;
+    gAbsentBattlerFlags = 0;
+    gFieldStatuses = 0;
+    gBattlerAttacker = 0;
+    gCurrentMove = MOVE_NONE;
+    for (battler = 0; battler < MAX_BATTLERS_COUNT; battler++)
+    {
+        gBattleMons[battler].ability = abilities[battler];
+        gBattleMons[battler].hp = 100;
+        gBattleMons[battler].maxHP = 100;
+    }
+    InvalidateAbilityCache();
+}
+
+static void BenchmarkGetBattlerAbility(void)
+{
+    struct Benchmark oldGetBattlerAbility, newGetBattlerAbility;
+    u32 battler, oldAbilities = 0, newAbilities = 0;
+
+    // Build the cache outside of the benchmark, it's only rebuilt when something changes.
+    GetBattlerAbility(0);
+    BENCHMARK(&oldGetBattlerAbility)
+    {
+        for (battler = 0; battler < gBattlersCount; battler++)
+            oldAbilities += Old_GetBattlerAbility(battler);
+    }
+    BENCHMARK(&newGetBattlerAbility)
+    {
+        for (battler = 0; battler < gBattlersCount; battler++)
+            newAbilities += GetBattlerAbility(battler);
+    }
+
+    EXPECT_EQ(oldAbilities, newAbilities);
+    EXPECT_FASTER(newGetBattlerAbility, oldGetBattlerAbility);
+}
+
+static void BenchmarkIsAbilityOnField(u32 ability)
+{
+    struct Benchmark oldIsAbilityOnField, newIsAbilityOnField;
+    u32 oldOnField = 0, newOnField = 0;
+
+    GetBattlerAbility(0);
+    BENCHMARK(&oldIsAbilityOnField)
+    {
+        oldOnField = Old_IsAbilityOnField(ability);
+    }
+    BENCHMARK(&newIsAbilityOnField)
+    {
+        newOnField = IsAbilityOnField(ability);
+    }
+
+    EXPECT_EQ(oldOnField, newOnField);
+    EXPECT_FASTER(newIsAbilityOnField, oldIsAbilityOnField);
+}
+
+TEST("GetBattlerAbility faster with the ability cache")
+{
+    SetUpBattlers();
+    BenchmarkGetBattlerAbility();
+}
+
+TEST("GetBattlerAbility faster with the ability cache (Neutralizing Gas)")
+{
+    SetUpBattlers();
+    gBattleMons[B_POSITION_OPPONENT_RIGHT].ability = ABILITY_NEUTRALIZING_GAS;
+    InvalidateAbilityCache();
+    BenchmarkGetBattlerAbility();
+}
+
+TEST("IsAbilityOnField faster with the ability cache (not on field)")
+{
+    SetUpBattlers();
+    BenchmarkIsAbilityOnField(ABILITY_DROUGHT);
+}
+
+TEST("IsAbilityOnField faster with the ability cache (suppressed by Gastro Acid)")
+{
+    SetUpBattlers();
+    gStatuses3[B_POSITION_OPPONENT_RIGHT] |= STATUS3_GASTRO_ACID;
+    InvalidateAbilityCache();
+    BenchmarkIsAbilityOnField(ABILITY_SHADOW_TAG);
+}
+
+TEST("GetBattlerAbility sees changes to items and HP without invalidating the ability cache")
+{
+    SetUpBattlers();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_LEFT), ABILITY_LEVITATE);
+    EXPECT(IsAbilityOnField(ABILITY_SHADOW_TAG));
+
+    gStatuses3[B_POSITION_PLAYER_LEFT] |= STATUS3_GASTRO_ACID;
+    InvalidateAbilityCache();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_LEFT), ABILITY_NONE);
+
+    gBattleMons[B_POSITION_OPPONENT_LEFT].ability = ABILITY_NEUTRALIZING_GAS;
+    InvalidateAbilityCache();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_RIGHT), ABILITY_NONE);
+    EXPECT(!IsAbilityOnField(ABILITY_SHADOW_TAG));
+
+    gBattleMons[B_POSITION_PLAYER_RIGHT].item = ITEM_ABILITY_SHIELD;
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_RIGHT), ABILITY_KLUTZ);
+
+    gBattleMons[B_POSITION_OPPONENT_LEFT].hp = 0;
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), ABILITY_SHADOW_TAG);
+    EXPECT_EQ(IsAbilityOnField(ABILITY_SHADOW_TAG), B_POSITION_OPPONENT_RIGHT + 1);
+}
+
+TEST("GetBattlerAbility matches the uncached lookup for battlers past gBattlersCount")
+{
+    SetUpBattlers();
+    gBattlersCount = 2;
+    gBattleMons[B_POSITION_OPPONENT_RIGHT].item = ITEM_ABILITY_SHIELD;
+    gPotentialItemEffectBattler = B_POSITION_PLAYER_LEFT;
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), ABILITY_SHADOW_TAG);
+    EXPECT_EQ(gPotentialItemEffectBattler, B_POSITION_OPPONENT_RIGHT);
+
+    gStatuses3[B_POSITION_OPPONENT_RIGHT] |= STATUS3_GASTRO_ACID;
+    InvalidateAbilityCache();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), Old_GetBattlerAbility(B_POSITION_OPPONENT_RIGHT));
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), ABILITY_NONE);
+
+    // Only battlers on the field count for Neutralizing Gas.
+    gStatuses3[B_POSITION_OPPONENT_RIGHT] = 0;
+    gBattleMons[B_POSITION_OPPONENT_RIGHT].item = ITEM_NONE;
+    gBattleMons[B_POSITION_OPPONENT_LEFT].ability = ABILITY_NEUTRALIZING_GAS;
+    InvalidateAbilityCache();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), Old_GetBattlerAbility(B_POSITION_OPPONENT_RIGHT));
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_OPPONENT_RIGHT), ABILITY_NONE);
+    gBattleMons[B_POSITION_OPPONENT_LEFT].ability = ABILITY_INTIMIDATE;
+    gBattleMons[B_POSITION_OPPONENT_RIGHT].ability = ABILITY_NEUTRALIZING_GAS;
+    InvalidateAbilityCache();
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_LEFT), Old_GetBattlerAbility(B_POSITION_PLAYER_LEFT));
+    EXPECT_EQ(GetBattlerAbility(B_POSITION_PLAYER_LEFT), ABILITY_LEVITATE);
+}
+
+// The uncached functions that the ability cache replaced.
+
+static inline bool32 Old_CanBreakThroughAbility(u32 battlerAtk, u32 battlerDef, u32 ability, u32 hasAbilityShield, u32 ignoreMoldBreaker)
+{
+    if (hasAbilityShield || ignoreMoldBreaker)
+        return FALSE;
+
+    return ((IsMoldBreakerTypeAbility(battlerAtk, ability) || MoveIgnoresTargetAbility(gCurrentMove))
+         && battlerDef != battlerAtk
+         && gAbilitiesInfo[gBattleMons[battlerDef].ability].breakable
+         && gBattlerByTurnOrder[gCurrentTurnActionNumber] == battlerAtk
+         && gActionsByTurnOrder[gCurrentTurnActionNumber] == B_ACTION_USE_MOVE
+         && gCurrentTurnActionNumber < gBattlersCount);
+}
+
+static u32 Old_GetBattlerAbility(u32 battler)
+{
+    bool32 hasAbilityShield = GetBattlerHoldEffectIgnoreAbility(battler, TRUE) == HOLD_EFFECT_ABILITY_SHIELD;
+    bool32 abilityCantBeSuppressed = gAbilitiesInfo[gBattleMons[battler].ability].cantBeSuppressed;
+
+    if (abilityCantBeSuppressed)
+    {
+        // Edge case: pokemon under the effect of gastro acid transforms into a pokemon with Comatose (Todo: verify how other unsuppressable abilities behave)
+        if (gBattleMons[battler].status2 & STATUS2_TRANSFORMED
+            && gStatuses3[battler] & STATUS3_GASTRO_ACID
+            && gBattleMons[battler].ability == ABILITY_COMATOSE)
+                return ABILITY_NONE;
+
+        if (Old_CanBreakThroughAbility(gBattlerAttacker, battler, gBattleMons[gBattlerAttacker].ability, hasAbilityShield, FALSE))
+            return ABILITY_NONE;
+
+        return gBattleMons[battler].ability;
+    }
+
+    if (gStatuses3[battler] & STATUS3_GASTRO_ACID)
+        return ABILITY_NONE;
+
+    if (!hasAbilityShield
+     && Old_IsNeutralizingGasOnField()
+     && gBattleMons[battler].ability != ABILITY_NEUTRALIZING_GAS)
+        return ABILITY_NONE;
+
+    if (Old_CanBreakThroughAbility(gBattlerAttacker, battler, gBattleMons[gBattlerAttacker].ability, hasAbilityShield, FALSE))
+        return ABILITY_NONE;
+
+    return gBattleMons[battler].ability;
+}
+
+static bool32 Old_IsNeutralizingGasOnField(void)
+{
+    u32 i;
+
+    for (i = 0; i < gBattlersCount; i++)
+    {
+        if (IsBattlerAlive(i) && gBattleMons[i].ability == ABILITY_NEUTRALIZING_GAS && !(gStatuses3[i] & STATUS3_GASTRO_ACID))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static u32 Old_IsAbilityOnField(u32 ability)
+{
+    u32 i;
+
+    for (i = 0; i < gBattlersCount; i++)
+    {
+        if (IsBattlerAlive(i) && Old_GetBattlerAbility(i) == ability)
+            return i + 1;
+    }
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "global.h"
 #include "battle.h"
 #include "event_data.h"
+#include "malloc.h"
 #include "pokemon.h"
 #include "test/overworld_script.h"
 #include "test/test.h"
@@ -144,6 +145,79 @@ TEST("Status1 round-trips through BoxPokemon")
     EXPECT_EQ(GetMonData(&mon2, MON_DATA_STATUS), status1);
 }
 
+TEST("BoxMonView reads and writes the same data as GetBoxMonData/SetBoxMonData")
+{
+    u32 friendship = 123, move = MOVE_CELEBRATE;
+    struct Pokemon mon;
+    struct BoxMonView view;
+    CreateMon(&mon, SPECIES_WOBBUFFET, 50, 0, FALSE, 0, OT_ID_PRESET, 0);
+
+    OpenBoxMonView(&view, &mon.box);
+    EXPECT(view.isValid);
+    EXPECT_EQ(GetBoxMonViewData(&view, MON_DATA_SPECIES, NULL), SPECIES_WOBBUFFET);
+    EXPECT_EQ(GetLevelFromBoxMonViewExp(&view), 50);
+    SetBoxMonViewData(&view, MON_DATA_FRIENDSHIP, &friendship);
+    SetBoxMonViewData(&view, MON_DATA_MOVE2, &move);
+    CloseBoxMonView(&view);
+
+    EXPECT_EQ(GetMonData(&mon, MON_DATA_SANITY_IS_BAD_EGG), FALSE);
+    EXPECT_EQ(GetMonData(&mon, MON_DATA_FRIENDSHIP), friendship);
+    EXPECT_EQ(GetMonData(&mon, MON_DATA_MOVE2), move);
+    EXPECT_EQ(GetMonData(&mon, MON_DATA_SPECIES), SPECIES_WOBBUFFET);
+}
+
+TEST("CanLearnTeachableMove matches the teachable learnsets for all species and moves")
+{
+    u32 species, move, i;
+
+    for (species = SPECIES_NONE + 1; species < NUM_SPECIES; species++)
+    {
+        const u16 *learnset;
+
+        if (species == SPECIES_EGG || species == SPECIES_MEW || !IsSpeciesEnabled(species))
+            continue;
+
+        learnset = GetSpeciesTeachableLearnset(species);
+        for (move = MOVE_NONE + 1; move < MOVES_COUNT_ALL; move++)
+        {
+            bool32 expected = FALSE;
+
+            if (IsTeachableMoveUniversal(move))
+                continue;
+            for (i = 0; learnset[i] != MOVE_UNAVAILABLE; i++)
+            {
+                if (learnset[i] == move)
+                    expected = TRUE;
+            }
+            if (CanLearnTeachableMove(species, move) != expected)
+            {
+                Test_MgbaPrintf("species %d, move %d", species, move);
+                EXPECT_EQ(CanLearnTeachableMove(species, move), expected);
+            }
+        }
+    }
+}
+
+TEST("CanLearnTeachableMove handles universal moves")
+{
+    EXPECT(IsTeachableMoveUniversal(MOVE_RETURN));
+    EXPECT(IsTeachableMoveUniversal(MOVE_SUBSTITUTE));
+    EXPECT(!IsTeachableMoveUniversal(MOVE_TACKLE));
+    EXPECT(!IsTeachableMoveUniversal(MOVE_THUNDERBOLT));
+
+    EXPECT(CanLearnTeachableMove(SPECIES_BULBASAUR, MOVE_RETURN));
+    EXPECT(CanLearnTeachableMove(SPECIES_BULBASAUR, MOVE_SUBSTITUTE));
+    EXPECT(!CanLearnTeachableMove(SPECIES_CATERPIE, MOVE_SUBSTITUTE));
+    EXPECT(!CanLearnTeachableMove(SPECIES_EGG, MOVE_RETURN));
+    if (IsSpeciesEnabled(SPECIES_PYUKUMUKU))
+    {
+        EXPECT(!CanLearnTeachableMove(SPECIES_PYUKUMUKU, MOVE_RETURN));
+        EXPECT(CanLearnTeachableMove(SPECIES_PYUKUMUKU, MOVE_SUBSTITUTE));
+    }
+    if (IsSpeciesEnabled(SPECIES_TERAPAGOS))
+        EXPECT(!CanLearnTeachableMove(SPECIES_TERAPAGOS, MOVE_TERA_BLAST));
+}
+
 TEST("canhypertrain/hypertrain affect MON_DATA_HYPER_TRAINED_* and recalculate stats")
 {
     u32 atk, friendship = 0;
@@ -0,0 +1,109 @@
+#include "global.h"
+#include "gba/flash_internal.h"
+#include "agb_flash.h"
+#include "load_save.h"
+#include "main.h"
+#include "save.h"
+#include "test/test.h"
+
+// Unlike BENCHMARK, counts in 1024-cycle ticks so that a full save fits.
+static struct Benchmark TimeSave(void)
+{
+    REG_TM3CNT_H = 0;
+    REG_TM3CNT_L = 0;
+    REG_TM3CNT_H = TIMER_ENABLE | TIMER_1024CLK;
+    TrySavingData(SAVE_NORMAL);
+    REG_TM3CNT_H = 0;
+    return (struct Benchmark) { REG_TM3CNT_L };
+}
+
+TEST("Saving only rewrites the sectors that changed")
+{
+    struct Benchmark fullSave, dirtySave;
+    IntrFunc timer1Intr = gIntrTable[6], unused;
+    u8 playTimeSeconds;
+    u32 boxPersonality;
+
+    ASSUME(gFlashMemoryPresent == TRUE);
+
+    // The test runner uses Timer 2 for its timeouts.
+    SetFlashTimerIntr(1, &gIntrTable[6]);
+
+    ClearSaveData();
+    Save_ResetSaveCounters();
+    TrySavingData(SAVE_NORMAL);
+    fullSave = TimeSave();
+    gSaveBlock2Ptr->playTimeSeconds++;
+    dirtySave = TimeSave();
+    gPokemonStoragePtr->boxes[0][0].personality++;
+    TrySavingData(SAVE_NORMAL);
+
+    playTimeSeconds = gSaveBlock2Ptr->playTimeSeconds;
+    boxPersonality = gPokemonStoragePtr->boxes[0][0].personality;
+    gSaveBlock2Ptr->playTimeSeconds = 0;
+    gPokemonStoragePtr->boxes[0][0].personality = 0;
+    LoadGameSave(SAVE_NORMAL);
+
+    ClearSaveData();
+    Save_ResetSaveCounters();
+    SetFlashTimerIntr(2, &unused);
+    gIntrTable[6] = timer1Intr;
+
+    EXPECT_FASTER(dirtySave, fullSave);
+    EXPECT_EQ(gSaveFileStatus, SAVE_STATUS_OK);
+    EXPECT_EQ(gSaveBlock2Ptr->playTimeSeconds, playTimeSeconds);
+    EXPECT_EQ(gPokemonStoragePtr->boxes[0][0].personality, boxPersonality);
+}
+
+static u16 (*sProgramFlashSector)(u16, u8 *);
+static u16 sInterruptedSector;
+
+// Never programs sInterruptedSector, as if the game lost power right before writing it.
+static u16 ProgramFlashSector_Interrupted(u16 sectorNum, u8 *src)
+{
+    if (sectorNum == sInterruptedSector)
+        return 1;
+    return sProgramFlashSector(sectorNum, src);
+}
+
+TEST("Saving keeps the previous slot if interrupted before SaveBlock2 is written")
+{
+    IntrFunc timer1Intr = gIntrTable[6], unused;
+    u8 playTimeSeconds;
+    u32 boxPersonality;
+
+    ASSUME(gFlashMemoryPresent == TRUE);
+
+    // The test runner uses Timer 2 for its timeouts.
+    SetFlashTimerIntr(1, &gIntrTable[6]);
+
+    // Leave a complete save in both slots.
+    ClearSaveData();
+    Save_ResetSaveCounters();
+    TrySavingData(SAVE_NORMAL);
+    TrySavingData(SAVE_NORMAL);
+    playTimeSeconds = gSaveBlock2Ptr->playTimeSeconds;
+    boxPersonality = gPokemonStoragePtr->boxes[0][0].personality;
+
+    // The third save goes to the second slot. Normal saves don't rotate the
+    // sectors, so its SaveBlock2 sector is the slot's first one.
+    gSaveBlock2Ptr->playTimeSeconds++;
+    gPokemonStoragePtr->boxes[0][0].personality++;
+    sInterruptedSector = NUM_SECTORS_PER_SLOT + SECTOR_ID_SAVEBLOCK2;
+    sProgramFlashSector = ProgramFlashSector;
+    ProgramFlashSector = ProgramFlashSector_Interrupted;
+    HandleSavingData(SAVE_NORMAL); // Not TrySavingData, which would open the save failed screen
+    ProgramFlashSector = sProgramFlashSector;
+
+    // The second slot now has a PokemonStorage sector newer than its SaveBlock2 sector.
+    LoadGameSave(SAVE_NORMAL);
+
+    ClearSaveData();
+    Save_ResetSaveCounters();
+    SetFlashTimerIntr(2, &unused);
+    gIntrTable[6] = timer1Intr;
+
+    EXPECT_EQ(gSaveFileStatus, SAVE_STATUS_ERROR);
+    EXPECT_EQ(gSaveBlock2Ptr->playTimeSeconds, playTimeSeconds);
+    EXPECT_EQ(gPokemonStoragePtr->boxes[0][0].personality, boxPersonality);
+}
@@ -11,6 +11,22 @@ EWRAM_DATA static u16 sSpritePriorities[MAX_SPRITES] = {0};
 EWRAM_DATA static u8 sSpriteOrder[MAX_SPRITES] = {0};
 
 static void Old_BuildOamBuffer(void);
+static void Old_AnimateSprites(void);
+
+static u32 sCallbackCount;
+
+static void SpriteCB_Count(struct Sprite *sprite)
+{
+    sCallbackCount++;
+}
+
+// Creates a sprite in a later slot, which should be animated in the same frame.
+static void SpriteCB_CreateSprite(struct Sprite *sprite)
+{
+    CreateInvisibleSprite(SpriteCB_Count);
+    sCallbackCount = 0;
+    sprite->callback = SpriteCallbackDummy;
+}
 
 static void ExpectEqOamBuffers(const struct OamData *oldOamBuffer, const struct OamData *newOamBuffer)
 {
@@ -121,6 +137,50 @@ TEST("BuildOamBuffer faster with mix of sprites")
     BenchmarkBuildOamBuffer(FALSE);
 }
 
+TEST("BuildOamBuffer faster with max sprites (random priority/y/subpriority)")
+{
+    u32 i;
+    ResetSpriteData_();
+    SeedRng(0);
+    for (i = 0; i < MAX_SPRITES; i++)
+    {
+        u32 spriteId = CreateSprite(&gDummySpriteTemplate, 0, Random() % 256, Random() % 256);
+        gSprites[spriteId].oam.priority = Random() % 4;
+    }
+    BenchmarkBuildOamBuffer(FALSE);
+}
+
+TEST("AnimateSprites faster with few sprites")
+{
+    u32 i;
+    struct Benchmark oldAnimateSprites, newAnimateSprites;
+
+    ResetSpriteData_();
+    for (i = 0; i < 4; i++)
+        CreateSprite(&gDummySpriteTemplate, 0, 0, 0);
+
+    BENCHMARK(&oldAnimateSprites)
+    {
+        Old_AnimateSprites();
+    }
+    BENCHMARK(&newAnimateSprites)
+    {
+        AnimateSprites();
+    }
+
+    EXPECT_FASTER(newAnimateSprites, oldAnimateSprites);
+}
+
+TEST("AnimateSprites visits sprites created by earlier callbacks")
+{
+    ResetSpriteData_();
+    CreateInvisibleSprite(SpriteCB_CreateSprite);
+    AnimateSprites();
+    EXPECT_EQ(sCallbackCount, 1);
+    AnimateSprites();
+    EXPECT_EQ(sCallbackCount, 2);
+}
+
 // Old implementation.
 
 #define UBFIX
@@ -301,3 +361,20 @@ static void Old_BuildOamBuffer(void)
     gMain.oamLoadDisabled = temp;
     //sShouldProcessSpriteCopyRequests = TRUE;
 }
+
+static void Old_AnimateSprites(void)
+{
+    u32 i;
+    for (i = 0; i < MAX_SPRITES; i++)
+    {
+        struct Sprite *sprite = &gSprites[i];
+
+        if (sprite->inUse)
+        {
+            sprite->callback(sprite);
+
+            if (sprite->inUse)
+                AnimateSprite(sprite);
+        }
+    }
+}
@@ -11,6 +11,14 @@
 #include "test/test.h"
 
 #define TIMEOUT_SECONDS 60
+#define TIMER2_RELOAD (UINT16_MAX - (274 * 60)) // Approx. 1 second.
+
+// When profiling, Timer 2 interrupts every 16 * 1024 cycles (approx. 1kHz)
+// and the samples are sent to Hydra in lines of PROFILE_SAMPLES_PER_LINE.
+#define PROFILE_TICKS 16
+#define PROFILE_RELOAD (UINT16_MAX + 1 - PROFILE_TICKS)
+#define PROFILE_SAMPLES 256
+#define PROFILE_SAMPLES_PER_LINE 16
 
 void CB2_TestRunner(void);
 
@@ -27,12 +35,26 @@ __attribute__((section(".persistent"))) static struct {
     u32 state:1;
 } sCurrentTest = {0};
 
+/* A ring buffer of the interrupted pc and lr. The Timer 2 interrupt
+ * drains it once it is half full unless it interrupted a print, and
+ * the rest is drained when the test finishes. */
+EWRAM_DATA static struct {
+    u32 pc[PROFILE_SAMPLES];
+    u32 lr[PROFILE_SAMPLES];
+    u16 read;
+    u16 write;
+    u16 ticks;
+    bool8 inPrint;
+} sProfile = {0};
+
 void TestRunner_Battle(const struct Test *);
 
 static bool32 MgbaOpen_(void);
 static void MgbaExit_(u8 exitCode);
 static s32 MgbaVPrintf_(const char *fmt, va_list va);
 static void Intr_Timer2(void);
+static void Profile_Flush(void);
+static void Intr_Timer2_Timeout(void);
 
 extern const struct Test __start_tests[];
 extern const struct Test __stop_tests[];
@@ -53,6 +75,29 @@ static bool32 PrefixMatch(const char *pattern, const char *string)
     }
 }
 
+/* Hydra hands out work by patching [gTestRunnerRangeStart,
+ * gTestRunnerRangeEnd) and restarting the ROM once the range is done.
+ * An empty range means that every test is considered.
+ * The ASSUMPTIONS of the file that the range starts in are always run
+ * so that ranges can start in the middle of a file. */
+static bool32 TestInRange(const struct Test *test)
+{
+    u32 index = test - __start_tests;
+
+    if (gTestRunnerRangeEnd == 0)
+        return TRUE;
+    if (index >= gTestRunnerRangeStart)
+        return index < gTestRunnerRangeEnd;
+    return test->runner == &gAssumptionsRunner
+        && test->filename == __start_tests[gTestRunnerRangeStart].filename;
+}
+
+static bool32 TestPastRangeEnd(const struct Test *test)
+{
+    return gTestRunnerRangeEnd != 0
+        && (u32)(test - __start_tests) >= gTestRunnerRangeEnd;
+}
+
 enum
 {
     STATE_INIT,
@@ -104,6 +149,38 @@ static u32 AssignCostToRunner(void)
     return minCostProcess;
 }
 
+/* Reports the index of the test and how long it ran for in 1024-cycle
+ * ticks. Hydra records these to balance the next run. */
+static void ReportTestDuration(void)
+{
+    u32 ticks;
+
+    // The timer state does not survive a crash.
+    if (gTestRunnerState.test->runner == &gAssumptionsRunner
+     || gTestRunnerState.result == TEST_RESULT_CRASH)
+        return;
+
+    ticks = gTestRunnerState.timerOverflows * (UINT16_MAX + 1 - TIMER2_RELOAD);
+    if (gTestRunnerProfile)
+        ticks += sProfile.ticks + (REG_TM2CNT_L - PROFILE_RELOAD);
+    else
+        ticks += REG_TM2CNT_L - TIMER2_RELOAD;
+    Test_MgbaPrintf(":C%d:%d", gTestRunnerState.test - __start_tests, ticks);
+}
+
+/* Reports the peak heap usage, the smallest the largest free block got
+ * and the worst fragmentation of the test. Hydra lists the heaviest. */
+static void ReportHeapStats(void)
+{
+    const struct HeapStats *stats = GetHeapStats();
+
+    if (gTestRunnerState.test->runner == &gAssumptionsRunner
+     || gTestRunnerState.result == TEST_RESULT_CRASH)
+        return;
+
+    Test_MgbaPrintf(":M%d:%d:%d:%d", gTestRunnerState.test - __start_tests, stats->peakUsed, stats->minLargestFree, stats->maxFragmentation);
+}
+
 void TestRunner_CheckMemory(void)
 {
     if (gTestRunnerState.result == TEST_RESULT_PASS
@@ -225,12 +302,15 @@ top:
     case STATE_ASSIGN_TEST:
         while (1)
         {
-            if (gTestRunnerState.test == __stop_tests)
+            if (gTestRunnerState.test == __stop_tests
+             || TestPastRangeEnd(gTestRunnerState.test))
             {
                 gTestRunnerState.state = STATE_EXIT;
                 return;
             }
-            if (gTestRunnerState.test->runner != &gAssumptionsRunner
+            if (!TestInRange(gTestRunnerState.test))
+                ++gTestRunnerState.test;
+            else if (gTestRunnerState.test->runner != &gAssumptionsRunner
               && !PrefixMatch(gTestRunnerArgv, gTestRunnerState.test->name))
                 ++gTestRunnerState.test;
             else
@@ -249,7 +329,9 @@ top:
         InitHeap(gHeap, HEAP_SIZE);
         ResetTasks();
         EnableInterrupts(INTR_FLAG_TIMER2);
-        REG_TM2CNT_L = UINT16_MAX - (274 * 60); // Approx. 1 second.
+        gTestRunnerState.timerOverflows = 0;
+        sProfile.ticks = 0;
+        REG_TM2CNT_L = gTestRunnerProfile ? PROFILE_RELOAD : TIMER2_RELOAD;
         REG_TM2CNT_H = TIMER_ENABLE | TIMER_INTR_ENABLE | TIMER_1024CLK;
 
         sCurrentTest.address = (uintptr_t)gTestRunnerState.test;
@@ -289,6 +371,9 @@ top:
 
     case STATE_REPORT_RESULT:
         REG_TM2CNT_H = 0;
+        Profile_Flush();
+        ReportTestDuration();
+        ReportHeapStats();
 
         gTestRunnerState.state = STATE_NEXT_TEST;
 
@@ -503,8 +588,49 @@ void ReinitCallbacks(void)
     gMain.hblankCallback = NULL;
 }
 
-static void Intr_Timer2(void)
+// Called by Intr_Timer2 with the lr that IntrMain saved.
+static USED NOINLINE void Profile_Sample(u32 lr)
+{
+    u32 write = (sProfile.write + 1) % PROFILE_SAMPLES;
+    u32 pending = (sProfile.write - sProfile.read + PROFILE_SAMPLES) % PROFILE_SAMPLES;
+
+    // Drop the sample if the buffer is full.
+    if (write != sProfile.read)
+    {
+        sProfile.pc[sProfile.write] = IRQ_LR - 4;
+        sProfile.lr[sProfile.write] = lr;
+        sProfile.write = write;
+    }
+    if (pending >= PROFILE_SAMPLES / 2 && !sProfile.inPrint)
+        Profile_Flush();
+
+    sProfile.ticks += PROFILE_TICKS;
+    if (sProfile.ticks < UINT16_MAX + 1 - TIMER2_RELOAD)
+        return;
+    sProfile.ticks = 0;
+    Intr_Timer2_Timeout();
+}
+
+/* IntrMain pushes the interrupted code's lr onto the stack immediately
+ * before calling the handler, and the BIOS saved its pc in IRQ_LR. */
+static NAKED void Intr_Timer2(void)
 {
+    asm("ldr r1, =gTestRunnerProfile\n\
+         ldrb r1, [r1]\n\
+         cmp r1, #0\n\
+         beq 1f\n\
+         ldr r0, [sp]\n\
+         ldr r1, =Profile_Sample\n\
+         bx r1\n\
+     1:\n\
+         ldr r1, =Intr_Timer2_Timeout\n\
+         bx r1\n\
+         .pool");
+}
+
+static USED void Intr_Timer2_Timeout(void)
+{
+    gTestRunnerState.timerOverflows++;
     if (--gTestRunnerState.timeoutSeconds == 0)
     {
         if (gTestRunnerState.test->runner->checkProgress
@@ -579,6 +705,45 @@ static s32 MgbaPutchar_(s32 i, s32 c)
     return i;
 }
 
+static s32 MgbaPutHex_(s32 i, u32 value)
+{
+    s32 n;
+    for (n = 0; n < 7; n++)
+    {
+        unsigned nybble = (value >> (24 - (4*n))) & 0xF;
+        if (nybble <= 9)
+            i = MgbaPutchar_(i, '0' + nybble);
+        else
+            i = MgbaPutchar_(i, 'a' + nybble - 10);
+    }
+    return i;
+}
+
+// Sends the samples as ":S" followed by pairs of 7-digit pc and lr.
+static void Profile_Flush(void)
+{
+    s32 i = 0, n = 0;
+    while (sProfile.read != sProfile.write)
+    {
+        if (n == 0)
+        {
+            i = MgbaPutchar_(i, ':');
+            i = MgbaPutchar_(i, 'S');
+        }
+        i = MgbaPutHex_(i, sProfile.pc[sProfile.read]);
+        i = MgbaPutHex_(i, sProfile.lr[sProfile.read]);
+        sProfile.read = (sProfile.read + 1) % PROFILE_SAMPLES;
+        if (++n == PROFILE_SAMPLES_PER_LINE)
+        {
+            i = 254;
+            i = MgbaPutchar_(i, '\0');
+            n = 0;
+        }
+    }
+    if (i != 0)
+        REG_DEBUG_FLAGS = MGBA_LOG_INFO | 0x100;
+}
+
 extern const u8 gWireless_RSEtoASCIITable[];
 
 // Bare-bones, only supports plain %s, %S, and %d.
@@ -589,6 +754,7 @@ static s32 MgbaVPrintf_(const char *fmt, va_list va)
     u32 p;
     const char *s;
     const u8 *pokeS;
+    sProfile.inPrint = TRUE;
     while (*fmt)
     {
         switch ((c = *fmt++))
@@ -721,6 +887,7 @@ static s32 MgbaVPrintf_(const char *fmt, va_list va)
     {
         REG_DEBUG_FLAGS = MGBA_LOG_INFO | 0x100;
     }
+    sProfile.inPrint = FALSE;
     return i;
 }
 
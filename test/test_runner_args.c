@@ -5,4 +5,6 @@
 const bool8 gTestRunnerEnabled = TRUE;
 const u8 gTestRunnerN = 0;
 const u8 gTestRunnerI = 0;
+const u32 gTestRunnerRangeStart = 0;
+const u32 gTestRunnerRangeEnd = 0;
 const char gTestRunnerArgv[256] = {'\0'};
@@ -12,6 +12,7 @@
 #include "malloc.h"
 #include "random.h"
 #include "test/battle.h"
+#include "util.h"
 #include "window.h"
 #include "constants/characters.h"
 #include "constants/trainers.h"
@@ -354,7 +355,7 @@ static void BattleTest_Run(void *data)
     PrintTestName();
 }
 
-u32 RandomUniform(enum RandomTag tag, u32 lo, u32 hi)
+static u32 RandomUniformTest(enum RandomTag tag, u32 lo, u32 hi)
 {
     const struct BattlerTurn *turn = NULL;
 
@@ -386,7 +387,7 @@ u32 RandomUniform(enum RandomTag tag, u32 lo, u32 hi)
     return hi;
 }
 
-u32 RandomUniformExcept(enum RandomTag tag, u32 lo, u32 hi, bool32 (*reject)(u32))
+static u32 RandomUniformExceptTest(enum RandomTag tag, u32 lo, u32 hi, bool32 (*reject)(u32))
 {
     const struct BattlerTurn *turn = NULL;
     u32 default_;
@@ -437,7 +438,7 @@ u32 RandomUniformExcept(enum RandomTag tag, u32 lo, u32 hi, bool32 (*reject)(u32
     return default_;
 }
 
-u32 RandomWeightedArray(enum RandomTag tag, u32 sum, u32 n, const u8 *weights)
+static u32 RandomWeightedArrayTest(enum RandomTag tag, u32 sum, u32 n, const u8 *weights)
 {
     const struct BattlerTurn *turn = NULL;
 
@@ -503,7 +504,7 @@ u32 RandomWeightedArray(enum RandomTag tag, u32 sum, u32 n, const u8 *weights)
     }
 }
 
-const void *RandomElementArray(enum RandomTag tag, const void *array, size_t size, size_t count)
+static const void *RandomElementArrayTest(enum RandomTag tag, const void *array, size_t size, size_t count)
 {
     const struct BattlerTurn *turn = NULL;
     u32 index = count-1;
@@ -544,6 +545,45 @@ const void *RandomElementArray(enum RandomTag tag, const void *array, size_t siz
     return (const u8 *)array + size * index;
 }
 
+static void TraceEvent(enum TraceEventType type, u32 tag, u32 value)
+{
+    if (DATA.trial.traceEventsCount < MAX_TRACE_EVENTS)
+    {
+        DATA.trial.traceEvents[DATA.trial.traceEventsCount].type = type;
+        DATA.trial.traceEvents[DATA.trial.traceEventsCount].tag = tag;
+        DATA.trial.traceEvents[DATA.trial.traceEventsCount].value = value;
+    }
+    DATA.trial.traceEventsCount++;
+}
+
+u32 RandomUniform(enum RandomTag tag, u32 lo, u32 hi)
+{
+    u32 value = RandomUniformTest(tag, lo, hi);
+    TraceEvent(TRACE_RANDOM, tag, value);
+    return value;
+}
+
+u32 RandomUniformExcept(enum RandomTag tag, u32 lo, u32 hi, bool32 (*reject)(u32))
+{
+    u32 value = RandomUniformExceptTest(tag, lo, hi, reject);
+    TraceEvent(TRACE_RANDOM, tag, value);
+    return value;
+}
+
+u32 RandomWeightedArray(enum RandomTag tag, u32 sum, u32 n, const u8 *weights)
+{
+    u32 value = RandomWeightedArrayTest(tag, sum, n, weights);
+    TraceEvent(TRACE_RANDOM, tag, value);
+    return value;
+}
+
+const void *RandomElementArray(enum RandomTag tag, const void *array, size_t size, size_t count)
+{
+    const void *element = RandomElementArrayTest(tag, array, size, count);
+    TraceEvent(TRACE_RANDOM, tag, ((const u8 *)element - (const u8 *)array) / size);
+    return element;
+}
+
 static s32 TryAbilityPopUp(s32 i, s32 n, u32 battlerId, u32 ability)
 {
     struct QueuedAbilityEvent *event;
@@ -1196,6 +1236,11 @@ void TestRunner_Battle_RecordMessage(const u8 *string)
     s32 queuedEvent;
     s32 match;
     struct QueuedEvent *event;
+    u32 i, hash = FNV1A_INITIAL_HASH;
+
+    for (i = 0; string[i] != EOS; i++)
+        hash = HashWord(hash, string[i]);
+    TraceEvent(TRACE_MESSAGE, 0, hash);
 
     if (DATA.trial.queuedEvent == DATA.queuedEventsCount)
         return;
@@ -0,0 +1,684 @@
+/* Runs the tests that only exercise pure game logic on the host instead
+ * of in mgba-rom-test, see `make check-native`. The GBA memory map is
+ * mapped at its usual addresses so that register accesses are plain
+ * memory accesses, but DMA, interrupts, and the BIOS are not emulated.
+ * The ROM's assembly (scripts, map data, sound) is not linked in either,
+ * so a test that reaches it crashes, which is reported as CRASH.
+ *
+ * Output follows the same protocol as test_runner.c, and is printed the
+ * same way that mgba-rom-test-hydra would print it. */
+#include <setjmp.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "global.h"
+#include "event_data.h"
+#include "item_menu.h"
+#include "load_save.h"
+#include "malloc.h"
+#include "random.h"
+#include "task.h"
+#include "constants/characters.h"
+#include "test/test.h"
+
+#define MAX_SUMMARY_TESTS_TO_LIST 50
+
+struct TestRunnerState gTestRunnerState;
+struct FunctionTestRunnerState *gFunctionTestRunnerState;
+
+extern const struct Test __start_tests[];
+extern const struct Test __stop_tests[];
+
+static sigjmp_buf sExitJmp;
+
+static struct
+{
+    char testName[256];
+    char filenameLine[256];
+    char *output;
+    size_t outputSize;
+    size_t outputCapacity;
+    u32 results, passes, fails, knownFails, knownFailsPassing, todos, assumptionFails;
+    char failed[MAX_SUMMARY_TESTS_TO_LIST][2][256];
+    char assumeFailed[MAX_SUMMARY_TESTS_TO_LIST][2][256];
+    char knownFailingPassed[MAX_SUMMARY_TESTS_TO_LIST][2][256];
+} sHydra;
+
+static const struct { uintptr_t address; size_t size; } sGbaMemoryMap[] =
+{
+    { EWRAM_START, EWRAM_END - EWRAM_START },
+    { IWRAM_START, IWRAM_END - IWRAM_START },
+    { REG_BASE, 0x1000000 }, // Includes mgba's debug registers.
+    { PLTT, PLTT_SIZE },
+    { VRAM, VRAM_SIZE },
+    { OAM, OAM_SIZE },
+};
+
+static bool32 MapGbaMemory(void)
+{
+    u32 i;
+    for (i = 0; i < ARRAY_COUNT(sGbaMemoryMap); i++)
+    {
+        void *address = (void *)sGbaMemoryMap[i].address;
+        if (mmap(address, sGbaMemoryMap[i].size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0) != address)
+        {
+            perror("mmap GBA memory failed");
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// Faults are reported the same way that mgba-rom-test reports a crash.
+static void HandleCrash(int signal)
+{
+    Test_MgbaPrintf(":L%s:%d: %s", gTestRunnerState.test->filename, SourceLine(0), strsignal(signal));
+    gTestRunnerState.result = TEST_RESULT_CRASH;
+    siglongjmp(sExitJmp, 1);
+}
+
+static void InstallCrashHandlers(void)
+{
+    static const int signals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGTRAP };
+    struct sigaction action = { .sa_handler = HandleCrash };
+    u32 i;
+
+    sigemptyset(&action.sa_mask);
+    for (i = 0; i < ARRAY_COUNT(signals); i++)
+        sigaction(signals[i], &action, NULL);
+}
+
+static bool32 PrefixMatch(const char *pattern, const char *string)
+{
+    if (string == NULL)
+        return TRUE;
+
+    while (TRUE)
+    {
+        if (!*pattern)
+            return TRUE;
+        if (*pattern != *string)
+            return FALSE;
+        pattern++;
+        string++;
+    }
+}
+
+static void CopyLine(char *dest, const char *src)
+{
+    snprintf(dest, 256, "%s", src);
+}
+
+static void BufferOutput(const char *line)
+{
+    size_t n = strlen(line);
+    if (sHydra.outputSize + n + 1 >= sHydra.outputCapacity)
+    {
+        sHydra.outputCapacity = 2 * (sHydra.outputSize + n + 1);
+        sHydra.output = realloc(sHydra.output, sHydra.outputCapacity);
+        if (!sHydra.output)
+        {
+            perror("realloc output failed");
+            exit(2);
+        }
+    }
+    memcpy(sHydra.output + sHydra.outputSize, line, n);
+    sHydra.outputSize += n;
+    sHydra.output[sHydra.outputSize++] = '\n';
+}
+
+static void ListTest(char (*list)[2][256], u32 count)
+{
+    if (count < MAX_SUMMARY_TESTS_TO_LIST)
+    {
+        CopyLine(list[count][0], sHydra.testName);
+        CopyLine(list[count][1], sHydra.filenameLine);
+    }
+}
+
+// Handles a line the same way that mgba-rom-test-hydra does.
+static void HandleLine(const char *line)
+{
+    if (line[0] != ':')
+    {
+        BufferOutput(line);
+        return;
+    }
+
+    switch (line[1])
+    {
+    case 'N':
+        CopyLine(sHydra.testName, line + 2);
+        return;
+    case 'L':
+        CopyLine(sHydra.filenameLine, line + 2);
+        return;
+    case 'C':
+    case 'M':
+        return;
+    case 'P':
+        sHydra.passes++;
+        break;
+    case 'K':
+        sHydra.knownFails++;
+        break;
+    case 'U':
+        ListTest(sHydra.knownFailingPassed, sHydra.knownFailsPassing++);
+        break;
+    case 'T':
+        sHydra.todos++;
+        break;
+    case 'A':
+        ListTest(sHydra.assumeFailed, sHydra.assumptionFails++);
+        break;
+    case 'F':
+        ListTest(sHydra.failed, sHydra.fails++);
+        break;
+    default:
+        BufferOutput(line);
+        return;
+    }
+
+    sHydra.results++;
+    fprintf(stdout, "[0] %s: %s\n", sHydra.testName, line + 2);
+    fwrite(sHydra.output, 1, sHydra.outputSize, stdout);
+    strcpy(sHydra.testName, "WAITING...");
+    sHydra.outputSize = 0;
+}
+
+static void PrintSummaryList(const char *title, const char *color, char (*list)[2][256], u32 count)
+{
+    u32 i;
+    fprintf(stdout, "\n  %s:\n", title);
+    for (i = 0; i < count; i++)
+    {
+        if (i >= MAX_SUMMARY_TESTS_TO_LIST)
+        {
+            fprintf(stdout, "  - %sand %d more...\e[0m\n", color, count - MAX_SUMMARY_TESTS_TO_LIST);
+            break;
+        }
+        fprintf(stdout, "  - %s%s\e[0m - %s.\n", color, list[i][1], list[i][0]);
+    }
+}
+
+static void PrintSummary(void)
+{
+    if (sHydra.results == 0)
+    {
+        fprintf(stdout, "\nNo tests found.\n");
+        return;
+    }
+
+    if (sHydra.fails > 0)
+        PrintSummaryList("\e[31mFAILED\e[0m tests", "\e[31m", sHydra.failed, sHydra.fails);
+    if (sHydra.assumptionFails > 0)
+        PrintSummaryList("Tests with \e[33mASSUMPTIONS_FAILED\e[0m", "\e[33m", sHydra.assumeFailed, sHydra.assumptionFails);
+    if (sHydra.knownFailsPassing > 0)
+        PrintSummaryList("\e[33mKNOWN_FAILING\e[0m tests \e[32mPASSING\e[0m", "\e[32m", sHydra.knownFailingPassed, sHydra.knownFailsPassing);
+
+    fprintf(stdout, "\n");
+    if (sHydra.fails > 0)
+        fprintf(stdout, "- Tests \e[31mFAILED\e[0m :         %d    Add TESTS='X' to run tests with the defined prefix.\n", sHydra.fails);
+    if (sHydra.knownFails > 0)
+        fprintf(stdout, "- Tests \e[33mKNOWN_FAILING\e[0m:   %d\n", sHydra.knownFails);
+    if (sHydra.assumptionFails > 0)
+        fprintf(stdout, "- \e[33mASSUMPTIONS_FAILED\e[0m:    %d\n", sHydra.assumptionFails);
+    if (sHydra.todos > 0)
+        fprintf(stdout, "- Tests \e[33mTO_DO\e[0m:           %d\n", sHydra.todos);
+    if (sHydra.knownFailsPassing > 0)
+        fprintf(stdout, "- \e[32mKNOWN_FAILING_PASSING\e[0m: %d   \e[33mPlease remove KNOWN_FAILING if these tests intentionally PASS\e[0m\n", sHydra.knownFailsPassing);
+    fprintf(stdout, "- Tests \e[32mPASSED\e[0m:          %d\n", sHydra.passes);
+    fprintf(stdout, "- Tests \e[34mTOTAL\e[0m:           %d\n", sHydra.results);
+    fprintf(stdout, "\n");
+}
+
+static void CheckMemory(void)
+{
+    if (gTestRunnerState.result == TEST_RESULT_PASS
+     && !gTestRunnerState.expectLeaks)
+    {
+        const struct MemBlock *head = HeapHead();
+        const struct MemBlock *block = head;
+        do
+        {
+            if (block->magic != MALLOC_SYSTEM_ID
+             || !(gHeap <= (u8 *)block->next && (u8 *)block->next < gHeap + HEAP_SIZE)
+             || (block->next <= block && block->next != head))
+            {
+                Test_MgbaPrintf("gHeap corrupted block at %p", block);
+                gTestRunnerState.result = TEST_RESULT_ERROR;
+                break;
+            }
+
+            if (block->allocated)
+            {
+                Test_MgbaPrintf("<unknown>: %d bytes not freed", block->size);
+                gTestRunnerState.result = TEST_RESULT_FAIL;
+            }
+            block = block->next;
+        }
+        while (block != head);
+    }
+}
+
+static void ReportResult(void)
+{
+    const char *color;
+    const char *result;
+
+    if (gTestRunnerState.result == gTestRunnerState.expectedResult
+     || (gTestRunnerState.result == TEST_RESULT_FAIL
+      && gTestRunnerState.expectedResult == TEST_RESULT_KNOWN_FAIL))
+    {
+        color = "\e[32m";
+        Test_MgbaPrintf(":N%s", gTestRunnerState.test->name);
+    }
+    else if (gTestRunnerState.result != TEST_RESULT_ASSUMPTION_FAIL)
+    {
+        gTestRunnerState.exitCode = 1;
+        color = "\e[31m";
+    }
+    else
+    {
+        color = "";
+    }
+
+    switch (gTestRunnerState.result)
+    {
+    case TEST_RESULT_FAIL:
+        if (gTestRunnerState.expectedResult == TEST_RESULT_KNOWN_FAIL)
+        {
+            result = "KNOWN_FAILING";
+            color = "\e[33m";
+        }
+        else
+        {
+            result = "FAIL";
+        }
+        break;
+    case TEST_RESULT_PASS:
+        if (gTestRunnerState.result != gTestRunnerState.expectedResult)
+            result = "KNOWN_FAILING_PASS";
+        else
+            result = "PASS";
+        break;
+    case TEST_RESULT_ASSUMPTION_FAIL:
+        result = "ASSUMPTION_FAIL";
+        color = "\e[33m";
+        break;
+    case TEST_RESULT_TODO:
+        result = "TO_DO";
+        color = "\e[33m";
+        break;
+    case TEST_RESULT_INVALID:
+        result = "INVALID";
+        break;
+    case TEST_RESULT_ERROR:
+        result = "ERROR";
+        break;
+    case TEST_RESULT_CRASH:
+        result = "CRASH";
+        break;
+    default:
+        result = "UNKNOWN";
+        break;
+    }
+
+    if (gTestRunnerState.result == TEST_RESULT_PASS)
+    {
+        if (gTestRunnerState.result != gTestRunnerState.expectedResult)
+        {
+            Test_MgbaPrintf(":L%s:%d", gTestRunnerState.test->filename, SourceLine(0));
+            Test_MgbaPrintf(":U%s%s\e[0m", color, result);
+        }
+        else
+        {
+            Test_MgbaPrintf(":P%s%s\e[0m", color, result);
+        }
+    }
+    else if (gTestRunnerState.result == TEST_RESULT_ASSUMPTION_FAIL)
+        Test_MgbaPrintf(":A%s%s\e[0m", color, result);
+    else if (gTestRunnerState.result == TEST_RESULT_TODO)
+        Test_MgbaPrintf(":T%s%s\e[0m", color, result);
+    else if (gTestRunnerState.expectedResult == gTestRunnerState.result
+         || (gTestRunnerState.result == TEST_RESULT_FAIL
+          && gTestRunnerState.expectedResult == TEST_RESULT_KNOWN_FAIL))
+        Test_MgbaPrintf(":K%s%s\e[0m", color, result);
+    else
+        Test_MgbaPrintf(":F%s%s\e[0m", color, result);
+}
+
+static void RunTest(void)
+{
+    const struct Test *test = gTestRunnerState.test;
+
+    Test_MgbaPrintf(":N%s", test->name);
+    Test_MgbaPrintf(":L%s:%d", test->filename, test->sourceLine);
+    gTestRunnerState.result = TEST_RESULT_PASS;
+    gTestRunnerState.expectedResult = TEST_RESULT_PASS;
+    gTestRunnerState.expectLeaks = FALSE;
+    gTestRunnerState.tearDown = FALSE;
+    InitHeap(gHeap, HEAP_SIZE);
+    ResetTasks();
+
+    // Test_ExitWithResult returns here instead of to AgbMainLoop.
+    if (sigsetjmp(sExitJmp, TRUE) == 0)
+    {
+        SeedRng(0);
+        SeedRng2(0);
+        if (test->runner->setUp)
+        {
+            test->runner->setUp(test->data);
+            gTestRunnerState.tearDown = TRUE;
+        }
+        // NOTE: Assumes that the compiler interns __FILE__.
+        if (gTestRunnerState.skipFilename == test->filename)
+        {
+            Test_MgbaPrintf(":L%s:%d", test->filename, gTestRunnerState.failedAssumptionsBlockLine);
+            gTestRunnerState.result = TEST_RESULT_ASSUMPTION_FAIL;
+        }
+        else
+        {
+            test->runner->run(test->data);
+        }
+    }
+
+    if (gTestRunnerState.tearDown && test->runner->tearDown)
+    {
+        gTestRunnerState.tearDown = FALSE;
+        test->runner->tearDown(test->data);
+    }
+
+    CheckMemory();
+
+    if (test->runner == &gAssumptionsRunner)
+    {
+        if (gTestRunnerState.result != TEST_RESULT_PASS)
+            gTestRunnerState.skipFilename = test->filename;
+    }
+    else
+    {
+        ReportResult();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *prefix = argc > 1 ? argv[1] : "";
+
+    if (!MapGbaMemory())
+        return 2;
+    InstallCrashHandlers();
+
+    // The parts of AgbMain and CB2_TestRunner's setup that tests rely on.
+    SetSaveBlocksPointers(0);
+    ClearSav1();
+    ClearSav2();
+    ClearSav3();
+    gSaveBlock2Ptr->optionsBattleStyle = OPTIONS_BATTLE_STYLE_SET;
+
+    strcpy(sHydra.testName, "WAITING...");
+    gTestRunnerState.exitCode = 0;
+    gTestRunnerState.skipFilename = NULL;
+    for (gTestRunnerState.test = __start_tests; gTestRunnerState.test < __stop_tests; gTestRunnerState.test++)
+    {
+        if (gTestRunnerState.test->runner != &gAssumptionsRunner
+         && !PrefixMatch(prefix, gTestRunnerState.test->name))
+            continue;
+        RunTest();
+    }
+
+    PrintSummary();
+    if (sHydra.results == 0)
+        return 0;
+    return gTestRunnerState.exitCode;
+}
+
+void Test_ExpectedResult(enum TestResult result)
+{
+    gTestRunnerState.expectedResult = result;
+}
+
+void Test_ExpectLeaks(bool32 expectLeaks)
+{
+    gTestRunnerState.expectLeaks = expectLeaks;
+}
+
+static void FunctionTest_SetUp(void *data)
+{
+    (void)data;
+    gFunctionTestRunnerState = AllocZeroed(sizeof(*gFunctionTestRunnerState));
+    SeedRng(0);
+}
+
+static void FunctionTest_Run(void *data)
+{
+    void (*function)(void) = data;
+    do
+    {
+        if (gFunctionTestRunnerState->parameters)
+            Test_MgbaPrintf(":N%s %d/%d", gTestRunnerState.test->name, gFunctionTestRunnerState->runParameter + 1, gFunctionTestRunnerState->parameters);
+        gFunctionTestRunnerState->parameters = 0;
+        function();
+    } while (++gFunctionTestRunnerState->runParameter < gFunctionTestRunnerState->parameters);
+}
+
+static void FunctionTest_TearDown(void *data)
+{
+    (void)data;
+    FREE_AND_SET_NULL(gFunctionTestRunnerState);
+}
+
+const struct TestRunner gFunctionTestRunner =
+{
+    .setUp = FunctionTest_SetUp,
+    .run = FunctionTest_Run,
+    .tearDown = FunctionTest_TearDown,
+};
+
+static void Assumptions_Run(void *data)
+{
+    void (*function)(void) = data;
+    function();
+}
+
+const struct TestRunner gAssumptionsRunner =
+{
+    .run = Assumptions_Run,
+};
+
+static s32 NativeVPrintf_(const char *fmt, va_list va);
+
+void Test_ExitWithResult(enum TestResult result, u32 stopLine, const char *fmt, ...)
+{
+    gTestRunnerState.result = result;
+    gTestRunnerState.failedAssumptionsBlockLine = stopLine;
+    if (gTestRunnerState.result != gTestRunnerState.expectedResult)
+    {
+        if (!gTestRunnerState.test->runner->handleExitWithResult
+         || !gTestRunnerState.test->runner->handleExitWithResult(gTestRunnerState.test->data, result))
+        {
+            va_list va;
+            va_start(va, fmt);
+            NativeVPrintf_(fmt, va);
+            va_end(va);
+        }
+    }
+    siglongjmp(sExitJmp, 1);
+}
+
+s32 Test_MgbaPrintf(const char *fmt, ...)
+{
+    s32 n;
+    va_list va;
+    va_start(va, fmt);
+    n = NativeVPrintf_(fmt, va);
+    va_end(va);
+    return n;
+}
+
+static char PokeCharToAscii(u8 c)
+{
+    if (c == CHAR_SPACE)
+        return ' ';
+    else if (c >= CHAR_0 && c <= CHAR_9)
+        return '0' + c - CHAR_0;
+    else if (c >= CHAR_A && c <= CHAR_Z)
+        return 'A' + c - CHAR_A;
+    else if (c >= CHAR_a && c <= CHAR_z)
+        return 'a' + c - CHAR_a;
+    else
+        return '?';
+}
+
+// Supports the same conversions as MgbaVPrintf_ in test_runner.c.
+static s32 NativeVPrintf_(const char *fmt, va_list va)
+{
+    char line[1024];
+    s32 i = 0;
+    s32 c, d;
+    const char *s;
+    const u8 *pokeS;
+
+#define PUTCHAR(c_) do { if (i < (s32)sizeof(line) - 1) line[i++] = (c_); } while (0)
+    while (*fmt)
+    {
+        switch ((c = *fmt++))
+        {
+        case '%':
+            switch (*fmt++)
+            {
+            case '%':
+                PUTCHAR('%');
+                break;
+            case 'd':
+                i += snprintf(line + i, sizeof(line) - i, "%d", va_arg(va, int));
+                break;
+            case 'p':
+                i += snprintf(line + i, sizeof(line) - i, "<%p>", va_arg(va, void *));
+                break;
+            case 'q':
+                d = va_arg(va, int);
+                i += snprintf(line + i, sizeof(line) - i, "%.3g", d / 4096.0);
+                break;
+            case 's':
+                s = va_arg(va, const char *);
+                while ((c = *s++) != '\0')
+                    PUTCHAR(c);
+                break;
+            case 'S':
+                pokeS = va_arg(va, const u8 *);
+                if (pokeS == NULL)
+                    s = "NULL";
+                else
+                    s = "";
+                while ((c = *s++) != '\0')
+                    PUTCHAR(c);
+                while (pokeS != NULL && (c = *pokeS++) != EOS)
+                    PUTCHAR(PokeCharToAscii(c));
+                break;
+            }
+            if (i > (s32)sizeof(line) - 1)
+                i = sizeof(line) - 1;
+            break;
+        case '\n':
+            line[i] = '\0';
+            HandleLine(line);
+            i = 0;
+            break;
+        default:
+            PUTCHAR(c);
+            break;
+        }
+    }
+#undef PUTCHAR
+    if (i != 0)
+    {
+        line[i] = '\0';
+        HandleLine(line);
+    }
+    return i;
+}
+
+/* Host versions of the data, BIOS calls, and mgba logging that the logic
+ * under test uses. Everything else that lives in assembly is left
+ * unresolved, see NATIVE_LDFLAGS. */
+
+// The maps are assembled from data/maps.s, so the location in a cleared
+// save (group 0, map 0) is an empty map instead.
+static const struct MapHeader sMapHeader = {0};
+static const struct MapHeader *const sMapGroup[] = { &sMapHeader };
+const struct MapHeader *const *gMapGroups[] = { sMapGroup };
+
+// From data/event_scripts.s.
+extern u16 gSpecialVar_0x8014;
+u16 *const gSpecialVars[] =
+{
+    &gSpecialVar_0x8000, &gSpecialVar_0x8001, &gSpecialVar_0x8002, &gSpecialVar_0x8003,
+    &gSpecialVar_0x8004, &gSpecialVar_0x8005, &gSpecialVar_0x8006, &gSpecialVar_0x8007,
+    &gSpecialVar_0x8008, &gSpecialVar_0x8009, &gSpecialVar_0x800A, &gSpecialVar_0x800B,
+    &gSpecialVar_Facing, &gSpecialVar_Result, &gSpecialVar_ItemId, &gSpecialVar_LastTalked,
+    &gSpecialVar_MonBoxId, &gSpecialVar_MonBoxPos, &gSpecialVar_TextColor, &gSpecialVar_PrevTextColor,
+    &gSpecialVar_0x8014,
+};
+
+void CpuSet(const void *src, void *dest, u32 control)
+{
+    u32 i, count = control & 0x1FFFFF;
+
+    if (control & CPU_SET_32BIT)
+    {
+        const u32 *src32 = src;
+        u32 *dest32 = dest;
+        for (i = 0; i < count; i++)
+            dest32[i] = (control & CPU_SET_SRC_FIXED) ? *src32 : src32[i];
+    }
+    else
+    {
+        const u16 *src16 = src;
+        u16 *dest16 = dest;
+        for (i = 0; i < count; i++)
+            dest16[i] = (control & CPU_SET_SRC_FIXED) ? *src16 : src16[i];
+    }
+}
+
+void CpuFastSet(const void *src, void *dest, u32 control)
+{
+    // CpuFastSet copies in blocks of 8 words.
+    CpuSet(src, dest, CPU_SET_32BIT | (control & CPU_FAST_SET_SRC_FIXED) | (((control & 0x1FFFFF) + 7) & ~7));
+}
+
+void MgbaPrintf(s32 level, const char *fmt, ...)
+{
+    char line[1024];
+    va_list va;
+    (void)level;
+    va_start(va, fmt);
+    vsnprintf(line, sizeof(line), fmt, va);
+    va_end(va);
+    HandleLine(line);
+}
+
+void MgbaAssert(const char *pFile, s32 nLine, const char *pExpression, bool32 nStopProgram)
+{
+    if (nStopProgram)
+        Test_ExitWithResult(TEST_RESULT_CRASH, SourceLine(0), ":L%s:%d: ASSERTION FAILED: %s", pFile, nLine, pExpression);
+    else
+        MgbaPrintf(MGBA_LOG_WARN, "WARING FILE=[%s] LINE=[%d]  EXP=[%s]", pFile, nLine, pExpression);
+}
+
+u32 SourceLine(u32 sourceLineOffset)
+{
+    return gTestRunnerState.test->sourceLine + sourceLineOffset;
+}
+
+u32 SourceLineOffset(u32 sourceLine)
+{
+    const struct Test *test = gTestRunnerState.test;
+    if (sourceLine - test->sourceLine > 0xFF)
+        return 0;
+    else
+        return sourceLine - test->sourceLine;
+}
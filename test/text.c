@@ -4,9 +4,11 @@
 #include "battle_main.h"
 #include "battle_message.h"
 #include "battle_setup.h"
+#include "blit.h"
 #include "item.h"
 #include "malloc.h"
 #include "main_menu.h"
+#include "random.h"
 #include "string_util.h"
 #include "text.h"
 #include "constants/abilities.h"
@@ -828,3 +830,180 @@ TEST("Battle strings fit on the battle message window")
     Free(battleString);
 }
 //*/
+
+static void Old_BlitBitmapRect4Bit(const struct Bitmap *src, struct Bitmap *dst, u16 srcX, u16 srcY, u16 dstX, u16 dstY, u16 width, u16 height, u8 colorKey);
+static void Old_FillBitmapRect4Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue);
+
+// The size of a message box.
+#define BLIT_BENCHMARK_WIDTH 224
+#define BLIT_BENCHMARK_HEIGHT 32
+#define BLIT_BENCHMARK_SIZE (BLIT_BENCHMARK_WIDTH * BLIT_BENCHMARK_HEIGHT / 2)
+
+static void RandomizeBitmap(struct Bitmap *bitmap)
+{
+    u32 i;
+    for (i = 0; i < BLIT_BENCHMARK_SIZE / 4; i++)
+        ((u32 *)bitmap->pixels)[i] = Random32();
+}
+
+TEST("BlitBitmapRect4Bit is faster than blitting a pixel at a time")
+{
+    u32 srcX = 0, dstX = 0, colorKey = 0;
+    struct Benchmark oldBlit, newBlit;
+    struct Bitmap src = { Alloc(BLIT_BENCHMARK_SIZE), BLIT_BENCHMARK_WIDTH, BLIT_BENCHMARK_HEIGHT };
+    struct Bitmap oldDst = { Alloc(BLIT_BENCHMARK_SIZE), BLIT_BENCHMARK_WIDTH, BLIT_BENCHMARK_HEIGHT };
+    struct Bitmap newDst = { Alloc(BLIT_BENCHMARK_SIZE), BLIT_BENCHMARK_WIDTH, BLIT_BENCHMARK_HEIGHT };
+
+    PARAMETRIZE { srcX = 0; dstX = 8; colorKey = 0xFF; } // Whole tiles.
+    PARAMETRIZE { srcX = 0; dstX = 8; colorKey = 0; }
+    PARAMETRIZE { srcX = 0; dstX = 13; colorKey = 0; } // Glyphs.
+    PARAMETRIZE { srcX = 5; dstX = 13; colorKey = 0xFF; }
+
+    RandomizeBitmap(&src);
+    RandomizeBitmap(&oldDst);
+    memcpy(newDst.pixels, oldDst.pixels, BLIT_BENCHMARK_SIZE);
+
+    BENCHMARK(&oldBlit)
+    {
+        Old_BlitBitmapRect4Bit(&src, &oldDst, srcX, 0, dstX, 8, 64, 16, colorKey);
+    }
+    BENCHMARK(&newBlit)
+    {
+        BlitBitmapRect4Bit(&src, &newDst, srcX, 0, dstX, 8, 64, 16, colorKey);
+    }
+
+    EXPECT(memcmp(oldDst.pixels, newDst.pixels, BLIT_BENCHMARK_SIZE) == 0);
+    EXPECT_FASTER(newBlit, oldBlit);
+    Free(src.pixels);
+    Free(oldDst.pixels);
+    Free(newDst.pixels);
+}
+
+TEST("FillBitmapRect4Bit is faster than filling a pixel at a time")
+{
+    u32 x = 0, width = 0;
+    struct Benchmark oldFill, newFill;
+    struct Bitmap oldSurface = { Alloc(BLIT_BENCHMARK_SIZE), BLIT_BENCHMARK_WIDTH, BLIT_BENCHMARK_HEIGHT };
+    struct Bitmap newSurface = { Alloc(BLIT_BENCHMARK_SIZE), BLIT_BENCHMARK_WIDTH, BLIT_BENCHMARK_HEIGHT };
+
+    PARAMETRIZE { x = 0; width = BLIT_BENCHMARK_WIDTH; } // Whole tiles.
+    PARAMETRIZE { x = 13; width = 5; } // Letter spacing.
+    PARAMETRIZE { x = 13; width = 150; }
+
+    RandomizeBitmap(&oldSurface);
+    memcpy(newSurface.pixels, oldSurface.pixels, BLIT_BENCHMARK_SIZE);
+
+    BENCHMARK(&oldFill)
+    {
+        Old_FillBitmapRect4Bit(&oldSurface, x, 0, width, 16, 1);
+    }
+    BENCHMARK(&newFill)
+    {
+        FillBitmapRect4Bit(&newSurface, x, 0, width, 16, 1);
+    }
+
+    EXPECT(memcmp(oldSurface.pixels, newSurface.pixels, BLIT_BENCHMARK_SIZE) == 0);
+    EXPECT_FASTER(newFill, oldFill);
+    Free(oldSurface.pixels);
+    Free(newSurface.pixels);
+}
+
+static void Old_BlitBitmapRect4Bit(const struct Bitmap *src, struct Bitmap *dst, u16 srcX, u16 srcY, u16 dstX, u16 dstY, u16 width, u16 height, u8 colorKey)
+{
+    s32 xEnd;
+    s32 yEnd;
+    s32 multiplierSrcY;
+    s32 multiplierDstY;
+    s32 loopSrcY, loopDstY;
+    s32 loopSrcX, loopDstX;
+    const u8 *pixelsSrc;
+    u8 *pixelsDst;
+    s32 toOrr;
+    s32 toAnd;
+    s32 toShift;
+
+    if (dst->width - dstX < width)
+        xEnd = (dst->width - dstX) + srcX;
+    else
+        xEnd = srcX + width;
+
+    if (dst->height - dstY < height)
+        yEnd = (dst->height - dstY) + srcY;
+    else
+        yEnd = height + srcY;
+
+    multiplierSrcY = (src->width + (src->width & 7)) >> 3;
+    multiplierDstY = (dst->width + (dst->width & 7)) >> 3;
+
+    if (colorKey == 0xFF)
+    {
+        for (loopSrcY = srcY, loopDstY = dstY; loopSrcY < yEnd; loopSrcY++, loopDstY++)
+        {
+            for (loopSrcX = srcX, loopDstX = dstX; loopSrcX < xEnd; loopSrcX++, loopDstX++)
+            {
+                pixelsSrc = src->pixels + ((loopSrcX >> 1) & 3) + ((loopSrcX >> 3) << 5) + (((loopSrcY >> 3) * multiplierSrcY) << 5) + ((u32)(loopSrcY << 0x1d) >> 0x1B);
+                pixelsDst = dst->pixels + ((loopDstX >> 1) & 3) + ((loopDstX >> 3) << 5) + (((loopDstY >> 3) * multiplierDstY) << 5) + ((u32)(loopDstY << 0x1d) >> 0x1B);
+                toOrr = ((*pixelsSrc >> ((loopSrcX & 1) << 2)) & 0xF);
+                toShift = ((loopDstX & 1) << 2);
+                toOrr <<= toShift;
+                toAnd = 0xF0 >> (toShift);
+                *pixelsDst = toOrr | (*pixelsDst & toAnd);
+            }
+        }
+    }
+    else
+    {
+        for (loopSrcY = srcY, loopDstY = dstY; loopSrcY < yEnd; loopSrcY++, loopDstY++)
+        {
+            for (loopSrcX = srcX, loopDstX = dstX; loopSrcX < xEnd; loopSrcX++, loopDstX++)
+            {
+                pixelsSrc = src->pixels + ((loopSrcX >> 1) & 3) + ((loopSrcX >> 3) << 5) + (((loopSrcY >> 3) * multiplierSrcY) << 5) + ((u32)(loopSrcY << 0x1d) >> 0x1B);
+                pixelsDst = dst->pixels + ((loopDstX >> 1) & 3) + ((loopDstX >> 3) << 5) + (((loopDstY >> 3) * multiplierDstY) << 5) + ((u32)(loopDstY << 0x1d) >> 0x1B);
+                toOrr = ((*pixelsSrc >> ((loopSrcX & 1) << 2)) & 0xF);
+                if (toOrr != colorKey)
+                {
+                    toShift = ((loopDstX & 1) << 2);
+                    toOrr <<= toShift;
+                    toAnd = 0xF0 >> (toShift);
+                    *pixelsDst = toOrr | (*pixelsDst & toAnd);
+                }
+            }
+        }
+    }
+}
+
+static void Old_FillBitmapRect4Bit(struct Bitmap *surface, u16 x, u16 y, u16 width, u16 height, u8 fillValue)
+{
+    s32 xEnd;
+    s32 yEnd;
+    s32 multiplierY;
+    s32 loopX, loopY;
+
+    xEnd = x + width;
+    if (xEnd > surface->width)
+        xEnd = surface->width;
+
+    yEnd = y + height;
+    if (yEnd > surface->height)
+        yEnd = surface->height;
+
+    multiplierY = (surface->width + (surface->width & 7)) >> 3;
+
+    for (loopY = y; loopY < yEnd; loopY++)
+    {
+        for (loopX = x; loopX < xEnd; loopX++)
+        {
+            u8 *pixels = surface->pixels + ((loopX >> 1) & 3) + ((loopX >> 3) << 5) + (((loopY >> 3) * multiplierY) << 5) + ((u32)(loopY << 0x1d) >> 0x1B);
+            if ((loopX & 1) != 0)
+            {
+                *pixels &= 0xF;
+                *pixels |= fillValue << 4;
+            }
+            else
+            {
+                *pixels &= 0xF0;
+                *pixels |= fillValue;
+            }
+        }
+    }
+}
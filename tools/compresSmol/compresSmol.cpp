@@ -31,7 +31,9 @@ int main(int argc, char *argv[])
     bool printUsage = false;
     std::string input;
     std::string output;
+    std::string cachePath;
     int numThreads = 1;
+    bool threadsGiven = false;
     InputSettings settings(true, true, true);
 
     if (argc > 1)
@@ -60,6 +62,12 @@ int main(int argc, char *argv[])
                 if (arg2.compare("-t") == 0 && isNumber(arg2arg))
                     numThreads = std::stoi(arg2arg.c_str());
             }
+            for (int i = 3; i < argc; i++)
+            {
+                std::string argument = argv[i];
+                if (argument.compare("-b") == 0)
+                    settings.benchmark = true;
+            }
             if (argc > 7)
             {
                 std::string setting1 = argv[5];
@@ -93,11 +101,27 @@ int main(int argc, char *argv[])
             {
                 input = argv[2];
                 output = argv[3];
-                if (argc > 6)
+                std::vector<std::string> settingArgs;
+                for (int i = 4; i < argc; i++)
+                {
+                    std::string argument = argv[i];
+                    if (argument.compare("-t") == 0 && i + 1 < argc && isNumber(argv[i + 1]))
+                    {
+                        numThreads = std::stoi(argv[++i]);
+                        threadsGiven = true;
+                    }
+                    else if (argument.compare("-c") == 0 && i + 1 < argc)
+                    {
+                        cachePath = argv[++i];
+                    }
+                    else
+                        settingArgs.push_back(argument);
+                }
+                if (settingArgs.size() > 2)
                 {
-                    std::string setting1 = argv[4];
-                    std::string setting2 = argv[5];
-                    std::string setting3 = argv[6];
+                    std::string setting1 = settingArgs[0];
+                    std::string setting2 = settingArgs[1];
+                    std::string setting3 = settingArgs[2];
                     if (setting1.compare("true") == 0)
                         settings.canEncodeLO = true;
                     else if (setting1.compare("false") == 0)
@@ -144,16 +168,22 @@ int main(int argc, char *argv[])
                 %s -a \"path/to/some/directory\"\n\
                     Analyses all images currently in .4bpp.lz format and compares with this compression.\n\
                     -t <number> can be appended to this mode to specify how many threads to use.\n\
+                    -b can be appended to this mode to report the throughput of each file and compare the match finders.\n\
                 \n\
                 %s -w \"path/to/some/file.4bpp\" \"path/to/some/file.4bpp.smol\"\
                     Compresses the first argument and writes the result to the second argument.\n\
+                %s -w \"path/to/some/directory\" .smol\n\
+                    Compresses every .4bpp file in the directory to a file with the second argument appended to its name.\n\
+                    Files whose contents and settings are unchanged since the last run are skipped.\n\
+                    -t <number> can be appended to this mode to specify how many threads to use, defaulting to all cores.\n\
+                    -c <file> can be appended to this mode to choose where the hashes are kept, defaulting to build/compresSmol/.\n\
                 These modes can also be appended with 4 true/false statements that control the following settings of the compression:\n\
                     - If the compression instructions can be tANS encoded.\n\
                     - If the raw symbols in the compression can be tANS encoded.\n\
                     - If the compression instructions can be delta encoded.\n\
                     - If the raw symbols in the compression ca be delta encoded.\n\
                 %s -d \"path/to/some/file.4bpp.smol\" \"path/to/some/file.4bpp\"\n\
-                    Decompresses the first argument and writes it to the second argument.", argv[0], argv[0], argv[0]);
+                    Decompresses the first argument and writes it to the second argument.", argv[0], argv[0], argv[0], argv[0]);
 
         return 0;
     }
@@ -189,9 +219,26 @@ int main(int argc, char *argv[])
         size_t rawSizes = 0;
         size_t totalImages = 0;
         size_t invalidImages = 0;
+        double processSeconds = 0;
+        double matchSeconds = 0;
+        double naiveMatchSeconds = 0;
+        size_t mismatchedImages = 0;
         for (CompressedImage currImage : allImages)
         {
             totalImages++;
+            if (settings.benchmark)
+            {
+                fprintf(stderr, "%s: %zu bytes in %.2f ms (%.1f KiB/s), match finder %.3f ms, naive %.3f ms%s\n",
+                        currImage.fileName.c_str(), currImage.rawNumBytes, currImage.processSeconds*1000,
+                        currImage.rawNumBytes/1024.0/currImage.processSeconds,
+                        currImage.matchSeconds*1000, currImage.naiveMatchSeconds*1000,
+                        currImage.matchesIdentical ? "" : " MISMATCH");
+                processSeconds += currImage.processSeconds;
+                matchSeconds += currImage.matchSeconds;
+                naiveMatchSeconds += currImage.naiveMatchSeconds;
+                if (!currImage.matchesIdentical)
+                    mismatchedImages++;
+            }
             if (currImage.isValid)
             {
                 lzSizes += currImage.lzSize;
@@ -210,8 +257,92 @@ int main(int argc, char *argv[])
         fprintf(stderr, "SmolSize: %zu\n", newSizes);
         fprintf(stderr, "Total Images: %zu\n", totalImages);
         fprintf(stderr, "Invalid Images: %zu\n", invalidImages);
+        if (settings.benchmark)
+        {
+            fprintf(stderr, "Throughput: %.1f KiB/s\n", rawSizes/1024.0/processSeconds);
+            fprintf(stderr, "Match finder: %.2f ms, naive: %.2f ms\n", matchSeconds*1000, naiveMatchSeconds*1000);
+            fprintf(stderr, "Mismatched Images: %zu\n", mismatchedImages);
+        }
+    }
+    if (option == WRITE && std::filesystem::is_directory(input))
+    {
+        std::filesystem::path dirPath = input;
+        FileDispatcher dispatcher(dirPath, ".4bpp");
+        if (!dispatcher.initFileList())
+        {
+            fprintf(stderr, "No .4bpp files in %s\n", input.c_str());
+            return 1;
+        }
+        std::mutex dispatchMutex;
+        std::vector<WrittenImage> allImages;
+        std::mutex imageMutex;
+
+        //  Content hashes of the inputs from the last run, one "hash path" per line.
+        //  They're kept with the other build outputs rather than next to the assets.
+        std::filesystem::path hashFilePath = cachePath;
+        if (hashFilePath.empty())
+        {
+            std::filesystem::path normalPath = dirPath.lexically_normal();
+            if (!normalPath.has_filename())
+                normalPath = normalPath.parent_path();
+            std::string cacheName = normalPath.generic_string();
+            std::replace(cacheName.begin(), cacheName.end(), '/', '_');
+            hashFilePath = std::filesystem::path("build") / "compresSmol" / (cacheName + output + ".cache");
+        }
+        if (hashFilePath.has_parent_path())
+            std::filesystem::create_directories(hashFilePath.parent_path());
+        std::map<std::string, unsigned long long> knownHashes;
+        std::ifstream hashFileIn(hashFilePath);
+        unsigned long long hash;
+        std::string fileName;
+        while (hashFileIn >> std::hex >> hash && std::getline(hashFileIn >> std::ws, fileName))
+            knownHashes[fileName] = hash;
+        hashFileIn.close();
+
+        if (!threadsGiven)
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++)
+        {
+            threads.emplace_back(writeImages, &allImages, &imageMutex,
+                                              &dispatcher, &dispatchMutex,
+                                              &knownHashes, output, settings);
+        }
+
+        for (int i = 0; i < numThreads; i++)
+            threads[i].join();
+
+        std::sort(allImages.begin(), allImages.end(), [](const WrittenImage &a, const WrittenImage &b) {
+            return a.fileName < b.fileName;
+        });
+
+        size_t skippedImages = 0;
+        size_t invalidImages = 0;
+        std::ofstream hashFileOut(hashFilePath);
+        for (const WrittenImage &currImage : allImages)
+        {
+            if (currImage.isValid)
+            {
+                hashFileOut << std::hex << currImage.inputHash << " " << currImage.fileName << "\n";
+                if (currImage.skipped)
+                    skippedImages++;
+            }
+            else
+            {
+                fprintf(stderr, "Failed to compress image %s\n", currImage.fileName.c_str());
+                invalidImages++;
+            }
+        }
+        hashFileOut.close();
+
+        fprintf(stderr, "Written Images: %zu\n", allImages.size() - skippedImages - invalidImages);
+        fprintf(stderr, "Unchanged Images: %zu\n", skippedImages);
+        fprintf(stderr, "Invalid Images: %zu\n", invalidImages);
+        if (invalidImages != 0)
+            return 1;
     }
-    if (option == WRITE)
+    else if (option == WRITE)
     {
         if (std::filesystem::exists(input))
         {
@@ -222,9 +353,7 @@ int main(int argc, char *argv[])
                 image = processImage(input, settings);
             if (image.isValid)
             {
-                std::ofstream fileOut(output.c_str(), std::ios::out | std::ios::binary);
-                fileOut.write(reinterpret_cast<const char *>(image.writeVec.data()), image.writeVec.size()*4);
-                fileOut.close();
+                writeCompressedImage(image, output);
             }
             else
             {
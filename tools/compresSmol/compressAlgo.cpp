@@ -1,17 +1,23 @@
 #include "compressAlgo.h"
 
-std::vector<ShortCopy> getShortCopies(std::vector<unsigned short> input, size_t minLength)
+#define MAX_COPY_OFFSET     32767
+#define MATCH_HASH_BITS     16
+#define NO_MATCH_POSITION   SIZE_MAX
+
+//  Brute-force reference for findLongestMatches, kept for benchmarking and
+//  for minimum lengths the hash chains can't serve.
+std::vector<ShortMatch> findLongestMatchesNaive(const std::vector<unsigned short> &input)
 {
-    std::vector<ShortCopy> copies;
+    std::vector<ShortMatch> matches(input.size());
     for (size_t startIndex = 1; startIndex < input.size(); startIndex++)
     {
         size_t longestLength = 0;
-        size_t longestOffset;
-        for (size_t searchOffset = 1; searchOffset <= startIndex && searchOffset < 32767; searchOffset++)
+        size_t longestOffset = 0;
+        for (size_t searchOffset = 1; searchOffset <= startIndex && searchOffset < MAX_COPY_OFFSET; searchOffset++)
         {
             size_t currLength = 0;
-            while (input[startIndex + currLength] == input[startIndex + currLength - searchOffset]
-                && startIndex + currLength < input.size())
+            while (startIndex + currLength < input.size()
+                && input[startIndex + currLength] == input[startIndex + currLength - searchOffset])
                 currLength++;
             if (currLength > longestLength)
             {
@@ -19,6 +25,77 @@ std::vector<ShortCopy> getShortCopies(std::vector<unsigned short> input, size_t
                 longestOffset = searchOffset;
             }
         }
+        matches[startIndex] = ShortMatch(longestLength, longestOffset);
+    }
+    return matches;
+}
+
+static size_t hashSymbolPair(unsigned short first, unsigned short second)
+{
+    unsigned int pair = ((unsigned int)first << 16) | second;
+    return (pair * 2654435761u) >> (32 - MATCH_HASH_BITS);
+}
+
+//  Finds the longest match, and the smallest offset giving it, for every
+//  position using hash chains keyed on the next two symbols. Matches shorter
+//  than two symbols aren't tracked.
+std::vector<ShortMatch> findLongestMatches(const std::vector<unsigned short> &input)
+{
+    std::vector<ShortMatch> matches(input.size());
+    if (input.size() < 2)
+        return matches;
+    std::vector<size_t> chainHeads(1 << MATCH_HASH_BITS, NO_MATCH_POSITION);
+    std::vector<size_t> chainLinks(input.size(), NO_MATCH_POSITION);
+    for (size_t startIndex = 0; startIndex + 1 < input.size(); startIndex++)
+    {
+        size_t hash = hashSymbolPair(input[startIndex], input[startIndex + 1]);
+        if (startIndex != 0)
+        {
+            size_t maxLength = input.size() - startIndex;
+            size_t longestLength = 0;
+            size_t longestOffset = 0;
+            //  Candidates come newest first, so the first longest match found has the smallest offset.
+            for (size_t candidate = chainHeads[hash];
+                 candidate != NO_MATCH_POSITION && startIndex - candidate < MAX_COPY_OFFSET;
+                 candidate = chainLinks[candidate])
+            {
+                //  Can't beat the current match if it differs at that length.
+                if (input[candidate + longestLength] != input[startIndex + longestLength])
+                    continue;
+                size_t currLength = 0;
+                while (currLength < maxLength && input[candidate + currLength] == input[startIndex + currLength])
+                    currLength++;
+                if (currLength > longestLength)
+                {
+                    longestLength = currLength;
+                    longestOffset = startIndex - candidate;
+                    if (longestLength == maxLength)
+                        break;
+                }
+            }
+            if (longestLength >= 2)
+                matches[startIndex] = ShortMatch(longestLength, longestOffset);
+        }
+        chainLinks[startIndex] = chainHeads[hash];
+        chainHeads[hash] = startIndex;
+    }
+    return matches;
+}
+
+std::vector<ShortCopy> getShortCopies(const std::vector<unsigned short> &input, size_t minLength)
+{
+    if (minLength < 2)
+        return getShortCopies(input, findLongestMatchesNaive(input), minLength);
+    return getShortCopies(input, findLongestMatches(input), minLength);
+}
+
+std::vector<ShortCopy> getShortCopies(const std::vector<unsigned short> &input, const std::vector<ShortMatch> &matches, size_t minLength)
+{
+    std::vector<ShortCopy> copies;
+    for (size_t startIndex = 1; startIndex < input.size(); startIndex++)
+    {
+        size_t longestLength = matches[startIndex].length;
+        size_t longestOffset = matches[startIndex].offset;
 
         if (longestLength > 32767)
             longestLength = 32767;
@@ -397,9 +474,11 @@ CompressedImage processImageData(std::vector<unsigned char> input, InputSettings
     std::vector<unsigned char> bestLO;
     std::vector<unsigned short> bestSym;
     std::vector<ShortCompressionInstruction> bestInstructions;
+    //  The longest matches don't depend on the minimum length, so find them once.
+    std::vector<ShortMatch> longestMatches = findLongestMatches(usBase);
     for (size_t minCodeLength = 2; minCodeLength <= 15; minCodeLength++)
     {
-        std::vector<ShortCopy> shortCopies = getShortCopies(usBase, minCodeLength);
+        std::vector<ShortCopy> shortCopies = getShortCopies(usBase, longestMatches, minCodeLength);
         if (!verifyShortCopies(&shortCopies, &usBase))
         {
             copyFail = true;
@@ -666,6 +745,48 @@ DataVecs decodeDataVectorsNew(CompressedImage *pInput)
     return returnData;
 }
 
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//  Times both match finders on the same image and checks that they agree.
+static void benchmarkMatchFinders(CompressedImage *pImage, std::string fileName)
+{
+    std::vector<unsigned char> input = readFileAsUC(fileName);
+    std::vector<unsigned short> usBase(input.size()/2);
+    memcpy(usBase.data(), input.data(), usBase.size()*2);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<ShortMatch> matches = findLongestMatches(usBase);
+    pImage->matchSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<ShortMatch> naiveMatches = findLongestMatchesNaive(usBase);
+    pImage->naiveMatchSeconds = secondsSince(start);
+
+    for (size_t minLength = 2; minLength <= 15; minLength++)
+    {
+        std::vector<ShortCopy> copies = getShortCopies(usBase, matches, minLength);
+        std::vector<ShortCopy> naiveCopies = getShortCopies(usBase, naiveMatches, minLength);
+        if (!verifyShortCopies(&copies, &usBase) || copies.size() != naiveCopies.size())
+        {
+            pImage->matchesIdentical = false;
+            return;
+        }
+        for (size_t i = 0; i < copies.size(); i++)
+        {
+            if (copies[i].index != naiveCopies[i].index
+             || copies[i].length != naiveCopies[i].length
+             || copies[i].offset != naiveCopies[i].offset)
+            {
+                pImage->matchesIdentical = false;
+                return;
+            }
+        }
+    }
+}
+
 void analyzeImages(std::vector<CompressedImage> *allImages, std::mutex *imageMutex, FileDispatcher *dispatcher, std::mutex *dispatchMutex, InputSettings settings)
 {
     std::string fileName = "Initial Value";
@@ -677,7 +798,11 @@ void analyzeImages(std::vector<CompressedImage> *allImages, std::mutex *imageMut
         if (fileName == "")
             break;
         std::string uncompressedFileName = fileName.substr(0, fileName.size()-3);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         CompressedImage currImage = processImage(uncompressedFileName, settings);
+        currImage.processSeconds = secondsSince(start);
+        if (settings.benchmark)
+            benchmarkMatchFinders(&currImage, uncompressedFileName);
 
         imageMutex->lock();
         allImages->push_back(currImage);
@@ -685,6 +810,72 @@ void analyzeImages(std::vector<CompressedImage> *allImages, std::mutex *imageMut
     }
 }
 
+//  FNV-1a over the input, followed by the settings that change the output.
+static unsigned long long hashImageInput(const std::vector<unsigned char> &input, InputSettings settings)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    for (unsigned char currByte : input)
+        hash = (hash ^ currByte) * 0x100000001b3ULL;
+    unsigned char settingBits = settings.canEncodeLO | (settings.canEncodeSyms << 1)
+                              | (settings.canDeltaSyms << 2) | (settings.useFrames << 3);
+    return (hash ^ settingBits) * 0x100000001b3ULL;
+}
+
+bool writeCompressedImage(const CompressedImage &image, std::string fileName)
+{
+    std::ofstream fileOut(fileName.c_str(), std::ios::out | std::ios::binary);
+    fileOut.write(reinterpret_cast<const char *>(image.writeVec.data()), image.writeVec.size()*4);
+    fileOut.close();
+    return !fileOut.fail();
+}
+
+void writeImages(std::vector<WrittenImage> *allImages, std::mutex *imageMutex, FileDispatcher *dispatcher, std::mutex *dispatchMutex, const std::map<std::string, unsigned long long> *knownHashes, std::string outputSuffix, InputSettings settings)
+{
+    std::string fileName = "Initial Value";
+    while (fileName != "")
+    {
+        dispatchMutex->lock();
+        fileName = dispatcher->requestFileName();
+        dispatchMutex->unlock();
+        if (fileName == "")
+            break;
+        std::string outputFileName = fileName + outputSuffix;
+        std::vector<unsigned char> input = readFileAsUC(fileName);
+        WrittenImage currImage;
+        currImage.fileName = fileName;
+        currImage.inputHash = hashImageInput(input, settings);
+
+        auto known = knownHashes->find(fileName);
+        if (known != knownHashes->end() && known->second == currImage.inputHash
+         && std::filesystem::exists(outputFileName))
+        {
+            currImage.skipped = true;
+            currImage.isValid = true;
+        }
+        else
+        {
+            CompressedImage image;
+            if (settings.useFrames)
+                image = processImageFrames(fileName, settings);
+            else
+                image = processImageData(input, settings, fileName);
+            if (image.isValid)
+                currImage.isValid = writeCompressedImage(image, outputFileName);
+        }
+
+        imageMutex->lock();
+        allImages->push_back(currImage);
+        imageMutex->unlock();
+    }
+}
+
+ShortMatch::ShortMatch() {}
+ShortMatch::ShortMatch(size_t length, size_t offset)
+{
+    this->length = length;
+    this->offset = offset;
+}
+
 ShortCopy::ShortCopy() {}
 ShortCopy::ShortCopy(size_t index, size_t length, size_t offset, std::vector<unsigned short> usSequence)
 {
@@ -9,6 +9,8 @@
 #include <thread>
 #include <string>
 #include <bitset>
+#include <chrono>
+#include <map>
 #include "fileDispatcher.h"
 #include "tANS.h"
 
@@ -49,6 +51,13 @@ enum CompressionMode {
     IS_TILEMAP = 8,
 };
 
+struct ShortMatch {
+    size_t length = 0;
+    size_t offset = 0;
+    ShortMatch();
+    ShortMatch(size_t length, size_t offset);
+};
+
 struct ShortCopy {
     size_t index;
     size_t length;
@@ -110,6 +119,10 @@ struct CompressedImage {
     std::vector<unsigned int> otherBits;
     std::vector<unsigned short> symVec;
     std::vector<unsigned char> loVec;
+    double processSeconds = 0;
+    double matchSeconds = 0;
+    double naiveMatchSeconds = 0;
+    bool matchesIdentical = true;
 };
 
 struct InputSettings {
@@ -118,16 +131,26 @@ struct InputSettings {
     bool canDeltaSyms = true;
     bool shouldCompare = false;
     bool useFrames = false;
+    bool benchmark = false;
     InputSettings();
     InputSettings(bool canEncodeLO, bool canEncodeSyms, bool canDeltaSyms);
 };
 
+struct WrittenImage {
+    std::string fileName;
+    unsigned long long inputHash = 0;
+    bool skipped = false;
+    bool isValid = false;
+};
+
 struct DataVecs {
     std::vector<unsigned char> loVec;
     std::vector<unsigned short> symVec;
 };
 
 void analyzeImages(std::vector<CompressedImage> *allImages, std::mutex *imageMutex, FileDispatcher *dispatcher, std::mutex *dispatchMutex, InputSettings settings);
+void writeImages(std::vector<WrittenImage> *allImages, std::mutex *imageMutex, FileDispatcher *dispatcher, std::mutex *dispatchMutex, const std::map<std::string, unsigned long long> *knownHashes, std::string outputSuffix, InputSettings settings);
+bool writeCompressedImage(const CompressedImage &image, std::string fileName);
 
 CompressedImage processImage(std::string fileName, InputSettings settings);
 CompressedImage processImageFrames(std::string fileName, InputSettings settings);
@@ -137,7 +160,10 @@ std::vector<unsigned int> readFileAsUInt(std::string filePath);
 
 size_t getCompressedSize(CompressedImage *pImage);
 
-std::vector<ShortCopy> getShortCopies(std::vector<unsigned short> input, size_t minLength);
+std::vector<ShortMatch> findLongestMatches(const std::vector<unsigned short> &input);
+std::vector<ShortMatch> findLongestMatchesNaive(const std::vector<unsigned short> &input);
+std::vector<ShortCopy> getShortCopies(const std::vector<unsigned short> &input, size_t minLength);
+std::vector<ShortCopy> getShortCopies(const std::vector<unsigned short> &input, const std::vector<ShortMatch> &matches, size_t minLength);
 bool verifyShortCopies(std::vector<ShortCopy> *pCopies, std::vector<unsigned short> *pImage);
 
 std::vector<int> getNormalizedCounts(std::vector<size_t> input);
@@ -5,6 +5,12 @@ FileDispatcher::FileDispatcher(std::filesystem::path inPath)
     setFilePath(inPath);
 }
 
+FileDispatcher::FileDispatcher(std::filesystem::path inPath, std::string inExtension)
+{
+    setFilePath(inPath);
+    fileExtension = inExtension;
+}
+
 void FileDispatcher::setFilePath(std::filesystem::path inPath)
 {
     filePath = inPath;
@@ -18,7 +24,8 @@ bool FileDispatcher::initFileList()
         if (dirEntry.is_regular_file())
         {
             fileName = dirEntry.path().string();
-            if (fileName.find(".4bpp.lz") == std::string::npos)
+            if (fileName.size() < fileExtension.size()
+             || fileName.compare(fileName.size() - fileExtension.size(), fileExtension.size(), fileExtension) != 0)
                 continue;
         }
         else
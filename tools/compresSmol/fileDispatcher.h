@@ -12,9 +12,11 @@ class FileDispatcher {
     int currentIndex = 0;
     std::mutex requestMutex;
     std::filesystem::path filePath;
+    std::string fileExtension = ".4bpp.lz";
 public:
     FileDispatcher();
     FileDispatcher(std::filesystem::path inPath);
+    FileDispatcher(std::filesystem::path inPath, std::string inExtension);
     void setFilePath(std::filesystem::path inPath);
     bool initFileList();
     std::string requestFileName();
@@ -151,3 +151,164 @@ unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize,
 fail:
 	FATAL_ERROR("Fatal error while compressing LZ file.\n");
 }
+
+#define LZ_MIN_BLOCK_SIZE 3
+#define LZ_MAX_BLOCK_SIZE 18
+#define LZ_MAX_DISTANCE 0x1000
+#define LZ_HASH_BITS 14
+#define LZ_NO_POSITION -1
+
+// Costs in bits, including the token's flag bit.
+#define LZ_LITERAL_COST 9
+#define LZ_BLOCK_COST 17
+
+static int LZHash(unsigned char *src, int pos)
+{
+	unsigned int key = (src[pos] << 16) | (src[pos + 1] << 8) | src[pos + 2];
+	return (key * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// Produces the smallest encoding by picking between literals and blocks with
+// dynamic programming. Only the longest block at each position is needed,
+// since every shorter block at the same distance also matches.
+unsigned char *LZCompressOptimal(unsigned char *src, int srcSize, int *compressedSize, const int minDistance)
+{
+	if (srcSize <= 0)
+		goto fail;
+
+	int *chainHeads = malloc(sizeof(int) << LZ_HASH_BITS);
+	int *chainLinks = malloc(sizeof(int) * srcSize);
+	int *bestSizes = malloc(sizeof(int) * srcSize);
+	int *bestDistances = malloc(sizeof(int) * srcSize);
+	int *costs = malloc(sizeof(int) * (srcSize + 1));
+
+	if (chainHeads == NULL || chainLinks == NULL || bestSizes == NULL || bestDistances == NULL || costs == NULL)
+		goto fail;
+
+	for (int i = 0; i < (1 << LZ_HASH_BITS); i++)
+		chainHeads[i] = LZ_NO_POSITION;
+
+	// Find the longest block at each position.
+	for (int srcPos = 0; srcPos < srcSize; srcPos++) {
+		int maxBlockSize = srcSize - srcPos;
+
+		if (maxBlockSize > LZ_MAX_BLOCK_SIZE)
+			maxBlockSize = LZ_MAX_BLOCK_SIZE;
+
+		bestSizes[srcPos] = 0;
+		bestDistances[srcPos] = 0;
+
+		if (maxBlockSize < LZ_MIN_BLOCK_SIZE) {
+			chainLinks[srcPos] = LZ_NO_POSITION;
+			continue;
+		}
+
+		int hash = LZHash(src, srcPos);
+
+		for (int blockStart = chainHeads[hash]; blockStart != LZ_NO_POSITION; blockStart = chainLinks[blockStart]) {
+			int blockDistance = srcPos - blockStart;
+			int blockSize = 0;
+
+			if (blockDistance > LZ_MAX_DISTANCE)
+				break;
+			if (blockDistance < minDistance)
+				continue;
+			if (src[blockStart + bestSizes[srcPos]] != src[srcPos + bestSizes[srcPos]])
+				continue;
+
+			while (blockSize < maxBlockSize && src[blockStart + blockSize] == src[srcPos + blockSize])
+				blockSize++;
+
+			if (blockSize > bestSizes[srcPos]) {
+				bestSizes[srcPos] = blockSize;
+				bestDistances[srcPos] = blockDistance;
+
+				if (blockSize == maxBlockSize)
+					break;
+			}
+		}
+
+		chainLinks[srcPos] = chainHeads[hash];
+		chainHeads[hash] = srcPos;
+	}
+
+	// costs[i] is the cheapest encoding of src[i..srcSize), and bestSizes[i]
+	// becomes the size of the block to emit at i (0 for a literal).
+	costs[srcSize] = 0;
+	for (int srcPos = srcSize - 1; srcPos >= 0; srcPos--) {
+		int longestBlockSize = bestSizes[srcPos];
+
+		costs[srcPos] = LZ_LITERAL_COST + costs[srcPos + 1];
+		bestSizes[srcPos] = 0;
+
+		for (int blockSize = LZ_MIN_BLOCK_SIZE; blockSize <= longestBlockSize; blockSize++) {
+			int cost = LZ_BLOCK_COST + costs[srcPos + blockSize];
+
+			if (cost < costs[srcPos]) {
+				costs[srcPos] = cost;
+				bestSizes[srcPos] = blockSize;
+			}
+		}
+	}
+
+	int worstCaseDestSize = 4 + srcSize + ((srcSize + 7) / 8);
+
+	// Round up to the next multiple of four.
+	worstCaseDestSize = (worstCaseDestSize + 3) & ~3;
+
+	unsigned char *dest = malloc(worstCaseDestSize);
+
+	if (dest == NULL)
+		goto fail;
+
+	// header
+	dest[0] = 0x10; // LZ compression type
+	dest[1] = (unsigned char)srcSize;
+	dest[2] = (unsigned char)(srcSize >> 8);
+	dest[3] = (unsigned char)(srcSize >> 16);
+
+	int srcPos = 0;
+	int destPos = 4;
+
+	for (;;) {
+		unsigned char *flags = &dest[destPos++];
+		*flags = 0;
+
+		for (int i = 0; i < 8; i++) {
+			int blockSize = bestSizes[srcPos];
+
+			if (blockSize != 0) {
+				int blockDistance = bestDistances[srcPos] - 1;
+				*flags |= (0x80 >> i);
+				srcPos += blockSize;
+				blockSize -= 3;
+				dest[destPos++] = (blockSize << 4) | ((unsigned int)blockDistance >> 8);
+				dest[destPos++] = (unsigned char)blockDistance;
+			} else {
+				dest[destPos++] = src[srcPos++];
+			}
+
+			if (srcPos == srcSize) {
+				// Pad to multiple of 4 bytes.
+				int remainder = destPos % 4;
+
+				if (remainder != 0) {
+					for (int i = 0; i < 4 - remainder; i++)
+						dest[destPos++] = 0;
+				}
+
+				free(chainHeads);
+				free(chainLinks);
+				free(bestSizes);
+				free(bestDistances);
+				free(costs);
+
+				*compressedSize = destPos;
+				return dest;
+			}
+		}
+	}
+
+fail:
+	FATAL_ERROR("Fatal error while compressing LZ file.\n");
+}
@@ -5,6 +5,9 @@ Usage: python3 make_teachable.py SOURCE_LEARNSETS_JSON
 
 Build a C-header defining the set of teachable moves for each configured-on
 species-family based on the learnable moves defined in SOURCE_LEARNSETS_JSON.
+Each learnset is stored with a bitset over all teachable moves, which
+CanLearnTeachableMove tests instead of scanning the learnset. The universal
+moves take the first bit indexes, so telling them apart is a single lookup too.
 
 A move is "teachable" if it is:
     1. Can be taught by some Move Tutor in the overworld, which is identified by
@@ -37,7 +40,9 @@ INCFILE_HAS_TUTOR_PAT = re.compile(r"special ChooseMonForMoveTutor")
 INCFILE_MOVE_PAT = re.compile(r"setvar VAR_0x8005, (MOVE_.*)")
 TMHM_MACRO_PAT = re.compile(r"F\((\w+)\)")
 UNIVERSAL_MOVES_PAT = re.compile(r"static const u16 sUniversalMoves\[\]\s*=\s*{((.|\n)*?)\n};")
-TEACHABLE_ARRAY_DECL_PAT = re.compile(r"(?P<decl>static const u16 s(?P<name>\w+)TeachableLearnset\[\]) = {[\s\S]*?};")
+TEACHABLE_ARRAY_DECL_PAT = re.compile(r"static const (u16 s(?P<name>\w+)TeachableLearnset\[\] = {[\s\S]*?};"
+                                      r"|struct TeachableLearnset s(?P<struct_name>\w+)TeachableLearnsetData = {[\s\S]*?\n};\n#define .*)")
+MOVE_PAT = re.compile(r"\bMOVE_\w+")
 SNAKIFY_PAT = re.compile(r"(?!^)([A-Z]+)")
 TUTOR_ARRAY_ENABLED_PAT = re.compile(r"#define\s+P_TUTOR_MOVES_ARRAY\s+(?P<cfg_val>[^ ]*)")
 
@@ -92,42 +97,86 @@ def extract_repo_universals() -> list[str]:
         return list()
 
 
-def prepare_output(all_learnables: dict[str, set[str]], repo_teachables: set[str], header: str) -> str:
+def prepare_learnset(name: str, moves: list[str], teachable_indexes: dict[str, int], universal_count: int) -> str:
+    """
+    Build a learnset along with its bitset over the teachable moves. The macro
+    keeps the name the species info refers to. Universal moves never have their
+    bits set, CanLearnTeachableMove has separate rules for them.
+    """
+    words = [0] * ((len(teachable_indexes) + 31) // 32)
+    for move in moves:
+        if move in teachable_indexes and teachable_indexes[move] >= universal_count:
+            i = teachable_indexes[move]
+            words[i // 32] |= 1 << (i % 32)
+
+    return "\n".join([
+        f"static const struct TeachableLearnset s{name}TeachableLearnsetData = {{",
+        f"    .bits = {{ {', '.join(f'0x{word:08X}' for word in words)} }},",
+         "    .moves = {",
+        *[f"        {move}," for move in chain(moves, ("MOVE_UNAVAILABLE",))],
+         "    },",
+         "};",
+        f"#define s{name}TeachableLearnset (&s{name}TeachableLearnsetData)",
+    ]) + "\n"
+
+
+def prepare_teachable_indexes(teachable_indexes: dict[str, int], universal_count: int) -> str:
+    """
+    Build the struct shared by the learnsets and the MOVE constant to bit index
+    lookup used by CanLearnTeachableMove.
+    """
+    lines = [
+        "",
+        f"#define TEACHABLE_UNIVERSAL_MOVES_COUNT {universal_count}",
+        f"#define TEACHABLE_MOVES_COUNT {len(teachable_indexes)}",
+         "#define TEACHABLE_LEARNSET_WORDS ((TEACHABLE_MOVES_COUNT + 31) / 32)",
+         "",
+         "// CanLearnTeachableMove only checks bits, moves lists the same moves for everything else.",
+         "struct TeachableLearnset",
+         "{",
+         "    u32 bits[TEACHABLE_LEARNSET_WORDS];",
+         "    u16 moves[];",
+         "};",
+         "",
+         "// Bit index + 1 of each teachable move, 0 for the rest.",
+         "// The first TEACHABLE_UNIVERSAL_MOVES_COUNT are the ones in sUniversalMoves.",
+        f"static const {'u8' if len(teachable_indexes) < 255 else 'u16'} sTeachableMoveIndexes[] = {{",
+    ]
+    lines.extend([f"    [{move}] = {i + 1}," for move, i in teachable_indexes.items()])
+    lines.extend(["};", ""])
+    return "\n".join(lines)
+
+
+def prepare_output(all_learnables: dict[str, set[str]], repo_teachables: set[str], repo_universals: list[str], header: str) -> str:
     """
     Build the file content for teachable_learnsets.h.
     """
     with open("./src/data/pokemon/teachable_learnsets.h", "r") as teachables_fp:
         old = teachables_fp.read()
 
+    teachable_indexes = {move: i for i, move in enumerate(chain(repo_universals, sorted(repo_teachables)))}
+    universal_count = len(repo_universals)
+
     cursor = 0
-    new = header + dedent("""
-    static const u16 sNoneTeachableLearnset[] = {
-        MOVE_UNAVAILABLE,
-    };
-    """)
+    new = header + prepare_teachable_indexes(teachable_indexes, universal_count) + "\n" + prepare_learnset("None", [], teachable_indexes, universal_count)
 
-    joinpat = ",\n    "
     for species in TEACHABLE_ARRAY_DECL_PAT.finditer(old):
         match_b, match_e = species.span()
-        species_upper = SNAKIFY_PAT.sub(r"_\1", species.group("name")).upper()
+        name = species.group("name") or species.group("struct_name")
+        species_upper = SNAKIFY_PAT.sub(r"_\1", name).upper()
         if species_upper == "NONE":
             # NONE is hard-coded to be at the start of the file to keep this code simple.
             cursor = match_e + 1
             continue
 
         if species_upper == "MEW":
-            new += old[cursor:match_e + 1] # copy the original content and skip.
-            cursor = match_e + 1
-            continue
-
-        repo_species_teachables = filter(lambda m: m in repo_teachables, all_learnables[species_upper])
+            # keep the original moves.
+            repo_species_teachables = [move for move in MOVE_PAT.findall(species.group(0)) if move != "MOVE_UNAVAILABLE"]
+        else:
+            repo_species_teachables = [move for move in all_learnables[species_upper] if move in repo_teachables]
 
         new += old[cursor:match_b]
-        new += "\n".join([
-            f"{species.group('decl')} = {{",
-            f"    {joinpat.join(chain(repo_species_teachables, ('MOVE_UNAVAILABLE',)))},",
-            "};\n",
-        ])
+        new += prepare_learnset(name, repo_species_teachables, teachable_indexes, universal_count)
         cursor = match_e + 1
 
     new += old[cursor:]
@@ -224,7 +273,7 @@ def main():
     with open(SOURCE_LEARNSETS_JSON, "r") as source_fp:
         all_learnables = json.load(source_fp)
 
-    content = prepare_output(all_learnables, repo_teachables, header)
+    content = prepare_output(all_learnables, repo_teachables, repo_universals, header)
     with open("./src/data/pokemon/teachable_learnsets.h", "w") as teachables_fp:
         teachables_fp.write(content)
 
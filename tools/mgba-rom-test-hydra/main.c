@@ -14,7 +14,39 @@
  * P/K/F/A: Sets the result to the remaining of the line, flushes any
  *    output since the previous P/K/F/A and increment the number of
  *    passes/known fails/assumption fails/fails.
+ * C: Sets the index of the current test and its duration in 1024-cycle
+ *    ticks, formatted as "index:ticks".
+ * S: Profiling samples, each a 7-digit hex pc followed by a 7-digit hex
+ *    lr, with no separators.
+ *
+ * SCHEDULING
+ * Hydra reads the tests out of the ELF and hands them out in ranges by
+ * patching gTestRunnerRangeStart/gTestRunnerRangeEnd. When a process
+ * finishes its range it exits and a new process is started on the next
+ * range, so runners that finish early pick up the remaining work.
+ *
+ * If a timings file is passed as the fourth argument, the measured
+ * duration of each test is saved to it, and on the next run the tests
+ * are split into ranges of similar duration which are handed out
+ * longest-first.
+ *
+ * INCREMENTAL
+ * If an object directory is passed as the fifth argument, Hydra builds
+ * the link graph of the objects in it and hashes every object that each
+ * test file can reach. Test files whose tests all passed with the same
+ * hashes are not run again, and their results are replayed from
+ * test_results.cache in that directory.
+ *
+ * PROFILING
+ * If the ROM sends samples (see gTestRunnerProfile), they are symbolized
+ * and the most sampled functions are listed in the summary. The samples
+ * are also saved as folded stacks, "caller;function count" per line, to
+ * test_profile.folded next to the timings file, which flamegraph.pl and
+ * similar tools accept. The caller is taken from lr, so it is only right
+ * if the function has not called anything since it was entered, and the
+ * stacks are at most two functions deep.
  */
+#include <dirent.h>
 #include <fcntl.h>
 #include <math.h>
 #include <poll.h>
@@ -32,6 +64,7 @@
 #endif
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 #include "elf.h"
 
@@ -40,6 +73,8 @@
 #define MAX_PROCESSES               32 // See also test/test.h
 #define MAX_SUMMARY_TESTS_TO_LIST   50
 #define MAX_TEST_LIST_BUFFER_LENGTH 256
+#define MAX_HEAP_TESTS_TO_LIST      5
+#define MAX_PROFILE_FUNCTIONS_TO_LIST 10
 
 #define ARRAY_COUNT(arr) (sizeof((arr)) / sizeof((arr)[0]))
 
@@ -56,6 +91,11 @@ struct Runner
     size_t output_buffer_size;
     size_t output_buffer_capacity;
     char *output_buffer;
+    struct timespec test_start;
+    bool test_ticks_valid;
+    uint32_t test_index;
+    uint32_t test_ticks;
+    int exit_code;
     int passes;
     int knownFails;
     int knownFailsPassing;
@@ -82,10 +122,93 @@ struct SymbolTable {
     size_t symbols_n;
 };
 
+struct TestInfo {
+    const char *name;
+    const char *filename;
+    uint16_t source_line;
+    bool selected;
+    bool measured;
+    bool cached;
+    char result;
+    uint64_t file_key;
+    uint64_t cycles;
+    uint64_t wall_us;
+    bool heap_measured;
+    uint32_t heap_peak;
+    uint32_t heap_min_largest_free;
+    uint32_t heap_max_fragmentation;
+};
+
+struct TestRange {
+    size_t start;
+    size_t end;
+    uint64_t cost;
+};
+
 static unsigned nrunners = 0;
 static unsigned runners_digits = 0;
 static struct Runner *runners = NULL;
 
+static const char *mgba_rom_test_path = NULL;
+static const char *objcopy_path = NULL;
+static void *elf = NULL;
+static size_t elf_size = 0;
+static pid_t parent_pid;
+
+static struct TestInfo *tests = NULL;
+static size_t tests_n = 0;
+static size_t tests_selected_remaining = 0;
+static size_t next_test = 0;
+
+// Ranges planned from the timings file, handed out in order.
+static struct TestRange *test_ranges = NULL;
+static size_t test_ranges_n = 0;
+static size_t next_test_range_i = 0;
+
+// Lines of the timings file for tests which are not in this ROM, kept
+// so that they are not lost when the file is saved.
+static char **unmatched_timings = NULL;
+static size_t unmatched_timings_n = 0;
+
+struct Object {
+    char *path;
+    char *data;
+    uint64_t hash;
+    size_t *deps;
+    size_t deps_n;
+    unsigned visited;
+};
+
+struct ObjectSymbol {
+    const char *name;
+    size_t object;
+};
+
+static struct Object *objects = NULL;
+static size_t objects_n = 0;
+static struct ObjectSymbol *object_symbols = NULL;
+static size_t object_symbols_n = 0;
+static unsigned object_visit = 0;
+
+// Results replayed from the cache.
+static int cached_passes = 0;
+static int cached_knownFails = 0;
+static int cached_todos = 0;
+
+// Sample counts of each [caller, function] pair of symbol indices, where
+// symbol_table.symbols_n stands for an unknown address. An open-addressed
+// hash table that is grown when it is half full.
+struct ProfileStack {
+    uint32_t caller;
+    uint32_t function;
+    uint64_t count;
+};
+
+static struct ProfileStack *profile_stacks = NULL;
+static size_t profile_stacks_n = 0;
+static size_t profile_stacks_c = 0;
+static uint64_t profile_samples = 0;
+
 // TODO: Build the symbol table on demand.
 static struct SymbolTable symbol_table = { NULL, 0 };
 
@@ -130,6 +253,95 @@ void *memmem(const void *haystack, size_t haystacklen, const void *needle, size_
 }
 #endif
 
+// Un-mirrors EWRAM/IWRAM/ROM addresses.
+static unsigned long unmirror_address(unsigned long address)
+{
+    switch (address & 0xF000000)
+    {
+    case 0x2000000: return address & 0x203FFFF;
+    case 0x3000000: return address & 0x3007FFF;
+    case 0x7000000: return address & 0x70003FF;
+    case 0xA000000: return address & 0x9FFFFFF;
+    case 0xB000000: return address & 0x9FFFFFF;
+    case 0xC000000: return address & 0x9FFFFFF;
+    case 0xD000000: return address & 0x9FFFFFF;
+    }
+    return address;
+}
+
+// Returns the index of the symbol containing address, or symbols_n.
+static uint32_t profile_symbol(uint32_t address)
+{
+    address = unmirror_address(address & ~1);
+    const struct Symbol *symbol = lookup_address(address);
+    // Thumb functions' symbols have bit 0 set.
+    if (symbol == NULL)
+        symbol = lookup_address(address | 1);
+    if (symbol == NULL)
+        return symbol_table.symbols_n;
+    return symbol - symbol_table.symbols;
+}
+
+static uint64_t profile_hash(uint32_t caller, uint32_t function)
+{
+    return ((uint64_t)caller * 0x9E3779B97F4A7C15ull) ^ function;
+}
+
+static void profile_add_stack(uint32_t caller, uint32_t function, uint64_t count)
+{
+    if (2 * (profile_stacks_n + 1) > profile_stacks_c)
+    {
+        struct ProfileStack *old_stacks = profile_stacks;
+        size_t old_stacks_c = profile_stacks_c;
+        profile_stacks_c = old_stacks_c ? 2 * old_stacks_c : 1024;
+        profile_stacks = calloc(profile_stacks_c, sizeof(*profile_stacks));
+        if (!profile_stacks)
+        {
+            perror("calloc profile_stacks failed");
+            exit(2);
+        }
+        profile_stacks_n = 0;
+        for (size_t i = 0; i < old_stacks_c; i++)
+        {
+            if (old_stacks[i].count > 0)
+                profile_add_stack(old_stacks[i].caller, old_stacks[i].function, old_stacks[i].count);
+        }
+        free(old_stacks);
+    }
+
+    size_t i = profile_hash(caller, function) & (profile_stacks_c - 1);
+    while (profile_stacks[i].count > 0
+        && (profile_stacks[i].caller != caller || profile_stacks[i].function != function))
+        i = (i + 1) & (profile_stacks_c - 1);
+    if (profile_stacks[i].count == 0)
+    {
+        profile_stacks[i].caller = caller;
+        profile_stacks[i].function = function;
+        profile_stacks_n++;
+    }
+    profile_stacks[i].count += count;
+}
+
+static void handle_profile_samples(const char *soc, const char *eol)
+{
+    char digits[8] = {0};
+    while (eol - soc >= 14)
+    {
+        memcpy(digits, soc, 7);
+        uint32_t pc = strtoul(digits, NULL, 16);
+        memcpy(digits, soc + 7, 7);
+        uint32_t lr = strtoul(digits, NULL, 16);
+        uint32_t function = profile_symbol(pc);
+        uint32_t caller = profile_symbol(lr);
+        // lr is stale, or the function was not called by a known function.
+        if (caller == function)
+            caller = symbol_table.symbols_n;
+        profile_add_stack(caller, function, 1);
+        profile_samples++;
+        soc += 14;
+    }
+}
+
 // Similar to 'fwrite(buffer, 1, size, f)' except that anything which
 // looks like the output of '%p' (i.e. '<0x\d{7}>') is translated into
 // the name of a symbol (if it represents one).
@@ -152,18 +364,7 @@ static void fprint_buffer(FILE *f, const char *buffer, size_t size)
         fwrite(buffer, 1, buffer_ - buffer, f);
         buffer = buffer_;
 
-        unsigned long address = strtoul(buffer + 3, &buffer_, 16);
-        // Un-mirror EWRAM/IWRAM/ROM addresses.
-        switch (address & 0xF000000)
-        {
-        case 0x2000000: address = address & 0x203FFFF; break;
-        case 0x3000000: address = address & 0x3007FFF; break;
-        case 0x7000000: address = address & 0x70003FF; break;
-        case 0xA000000: address = address & 0x9FFFFFF; break;
-        case 0xB000000: address = address & 0x9FFFFFF; break;
-        case 0xC000000: address = address & 0x9FFFFFF; break;
-        case 0xD000000: address = address & 0x9FFFFFF; break;
-        }
+        unsigned long address = unmirror_address(strtoul(buffer + 3, &buffer_, 16));
 
         // Not a 7-digit address, print the '<0x' part and loop.
         if (buffer_ != buffer + 10)
@@ -192,6 +393,29 @@ static void fprint_buffer(FILE *f, const char *buffer, size_t size)
     }
 }
 
+static uint64_t elapsed_us(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+// Called when a result is reported. The wall time includes the tests
+// skipped since the previous result, which are cheap.
+static void record_test_timing(struct Runner *runner, char result)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (runner->test_ticks_valid && runner->test_index < tests_n)
+    {
+        struct TestInfo *test = &tests[runner->test_index];
+        test->result = result;
+        test->measured = true;
+        test->cycles = (uint64_t)runner->test_ticks * 1024;
+        test->wall_us = elapsed_us(&runner->test_start, &now);
+    }
+    runner->test_ticks_valid = false;
+    runner->test_start = now;
+}
+
 static void handle_read(int i, struct Runner *runner)
 {
     char *sol = runner->input_buffer;
@@ -227,6 +451,26 @@ static void handle_read(int i, struct Runner *runner)
                     strncpy(runner->test_name, soc, eol - soc - 1);
                     runner->test_name[eol - soc - 1] = '\0';
                     break;
+                case 'C':
+                    if (sscanf(soc + 2, "%u:%u", &runner->test_index, &runner->test_ticks) == 2)
+                        runner->test_ticks_valid = true;
+                    break;
+                case 'S':
+                    handle_profile_samples(soc + 2, eol - 1);
+                    break;
+                case 'M':
+                {
+                    uint32_t test_index, peak, min_largest_free, max_fragmentation;
+                    if (sscanf(soc + 2, "%u:%u:%u:%u", &test_index, &peak, &min_largest_free, &max_fragmentation) == 4
+                     && test_index < tests_n)
+                    {
+                        tests[test_index].heap_measured = true;
+                        tests[test_index].heap_peak = peak;
+                        tests[test_index].heap_min_largest_free = min_largest_free;
+                        tests[test_index].heap_max_fragmentation = max_fragmentation;
+                    }
+                    break;
+                }
                 case 'L':
                     soc += 2;
                     if (sizeof(runner->filename_line) <= eol - soc - 1)
@@ -271,6 +515,7 @@ static void handle_read(int i, struct Runner *runner)
                     }
                     runner->fails++;
 add_to_results:
+                    record_test_timing(runner, soc[1]);
                     runner->results++;
                     soc += 2;
                     fprintf(stdout, "[%0*d] %s: ", runners_digits, i, runner->test_name);
@@ -327,20 +572,42 @@ buffer_output:
     }
 }
 
-static void unlink_roms(void)
+static void unlink_rom(struct Runner *runner)
 {
-    for (int i = 0; i < nrunners; i++)
+    if (runner->rom_path[0])
     {
-        if (runners[i].rom_path[0])
+        if (unlink(runner->rom_path) == -1)
         {
-            if (unlink(runners[i].rom_path) == -1)
-            {
-                int fd;
-                if ((fd = open(runners[i].rom_path, O_RDONLY)) != -1)
-                    perror("unlink rom_path failed");
-            }
+            int fd;
+            if ((fd = open(runner->rom_path, O_RDONLY)) != -1)
+                perror("unlink rom_path failed");
         }
+        runner->rom_path[0] = '\0';
+    }
+}
+
+static void reap_runner(struct Runner *runner)
+{
+    int wstatus;
+    if (waitpid(runner->pid, &wstatus, 0) == -1)
+    {
+        perror("waitpid runner failed");
+        exit(2);
+    }
+    if (runner->output_buffer_size > 0)
+    {
+        fwrite(runner->output_buffer, 1, runner->output_buffer_size, stdout);
+        runner->output_buffer_size = 0;
     }
+    if (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) > runner->exit_code)
+        runner->exit_code = WEXITSTATUS(wstatus);
+    unlink_rom(runner);
+}
+
+static void unlink_roms(void)
+{
+    for (int i = 0; i < nrunners; i++)
+        unlink_rom(&runners[i]);
 }
 
 static void exit2(int _)
@@ -424,242 +691,1109 @@ error:
     symbol_table.symbols_n = 0;
 }
 
-int main(int argc, char *argv[])
+// sizeof(struct Test) on the GBA, see include/test/test.h.
+#define TEST_STRUCT_SIZE 20
+
+// Returns a pointer to the data at 'address' in the ROM, or NULL if no
+// loaded section contains it.
+static const void *elf_pointer(uint32_t address)
 {
-    if (argc < 4)
+    const Elf32_Ehdr *ehdr = (Elf32_Ehdr *)elf;
+    const Elf32_Shdr *shdrs = (Elf32_Shdr *)(elf + ehdr->e_shoff);
+    for (int i = 0; i < ehdr->e_shnum; i++)
     {
-        fprintf(stderr, "usage %s mgba-rom-test objcopy rom\n", argv[0]);
-        exit(2);
+        if (!(shdrs[i].sh_flags & SHF_ALLOC) || shdrs[i].sh_type == SHT_NOBITS)
+            continue;
+        if (shdrs[i].sh_addr <= address && address < shdrs[i].sh_addr + shdrs[i].sh_size)
+            return elf + shdrs[i].sh_offset + (address - shdrs[i].sh_addr);
     }
+    return NULL;
+}
 
-    bool tty = isatty(STDOUT_FILENO);
-    if (!tty)
+static const Elf32_Sym *find_elf_symbol(const char *name)
+{
+    const Elf32_Ehdr *ehdr = (Elf32_Ehdr *)elf;
+    const Elf32_Shdr *shdrs = (Elf32_Shdr *)(elf + ehdr->e_shoff);
+
+    if (ehdr->e_shstrndx == SHN_UNDEF)
+        return NULL;
+    const Elf32_Shdr *shdr_shstr = &shdrs[ehdr->e_shstrndx];
+    const char *shstr = (const char *)(elf + shdr_shstr->sh_offset);
+    const Elf32_Shdr *shdr_symtab = NULL;
+    const Elf32_Shdr *shdr_strtab = NULL;
+    for (int i = 0; i < ehdr->e_shnum; i++)
     {
-        const char *v = getenv("MAKE_TERMOUT");
-        tty = v && v[0] == '\0';
+        const char *sh_name = shstr + shdrs[i].sh_name;
+        if (strcmp(sh_name, ".symtab") == 0)
+            shdr_symtab = &shdrs[i];
+        else if (strcmp(sh_name, ".strtab") == 0)
+            shdr_strtab = &shdrs[i];
     }
+    if (!shdr_symtab || !shdr_strtab)
+        return NULL;
 
-    if (tty)
+    const Elf32_Sym *symtab = (Elf32_Sym *)(elf + shdr_symtab->sh_offset);
+    const char *strtab = (const char *)(elf + shdr_strtab->sh_offset);
+    for (int i = 0; i < shdr_symtab->sh_size / shdr_symtab->sh_entsize; i++)
     {
-        char *stdout_buffer = malloc(64 * 1024);
-        if (!stdout_buffer)
+        if (symtab[i].st_name != 0 && strcmp(strtab + symtab[i].st_name, name) == 0)
+            return &symtab[i];
+    }
+    return NULL;
+}
+
+// Reads the tests out of the ROM so that they can be handed out on
+// demand. If the ROM predates gTestRunnerRange{Start,End}, tests_n is
+// left at 0 and the ROM partitions the tests itself.
+static void build_test_table(void)
+{
+    const Elf32_Sym *start_tests = find_elf_symbol("__start_tests");
+    const Elf32_Sym *stop_tests = find_elf_symbol("__stop_tests");
+    const Elf32_Sym *argv_sym = find_elf_symbol("gTestRunnerArgv");
+    if (!start_tests || !stop_tests || !argv_sym || !find_elf_symbol("gTestRunnerRangeEnd"))
+        return;
+    uint32_t tests_size = stop_tests->st_value - start_tests->st_value;
+    if (tests_size % TEST_STRUCT_SIZE != 0)
+        return;
+
+    const uint8_t *raw_tests = elf_pointer(start_tests->st_value);
+    const char *prefix = elf_pointer(argv_sym->st_value);
+    if (!raw_tests || !prefix)
+        return;
+
+    size_t n = tests_size / TEST_STRUCT_SIZE;
+    tests = calloc(n, sizeof(*tests));
+    if (!tests)
+    {
+        perror("calloc tests failed");
+        exit(2);
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t name_address, filename_address;
+        memcpy(&name_address, raw_tests + i * TEST_STRUCT_SIZE + 0, sizeof(name_address));
+        memcpy(&filename_address, raw_tests + i * TEST_STRUCT_SIZE + 4, sizeof(filename_address));
+        memcpy(&tests[i].source_line, raw_tests + i * TEST_STRUCT_SIZE + 16, sizeof(tests[i].source_line));
+        tests[i].name = elf_pointer(name_address);
+        tests[i].filename = elf_pointer(filename_address);
+        if (!tests[i].name || !tests[i].filename)
         {
-            perror("malloc stdout_buffer failed");
-            exit(2);
+            free(tests);
+            tests = NULL;
+            return;
         }
-        setvbuf(stdout, stdout_buffer, _IOFBF, 64 * 1024);
+        // Same as PrefixMatch in test/test_runner.c.
+        tests[i].selected = strncmp(tests[i].name, "ASSUMPTIONS: ", strlen("ASSUMPTIONS: ")) != 0
+                         && strncmp(tests[i].name, prefix, strlen(prefix)) == 0;
+        if (tests[i].selected)
+            tests_selected_remaining++;
     }
-    else
+    tests_n = n;
+}
+
+static int compare_tests(const struct TestInfo *a, const char *filename, unsigned source_line, const char *name)
+{
+    int c;
+    if ((c = strcmp(a->filename, filename)) != 0)
+        return c;
+    if (a->source_line != source_line)
+        return a->source_line < source_line ? -1 : 1;
+    return strcmp(a->name, name);
+}
+
+static int compare_test_indices(const void *a, const void *b)
+{
+    const struct TestInfo *tb = &tests[*(const size_t *)b];
+    return compare_tests(&tests[*(const size_t *)a], tb->filename, tb->source_line, tb->name);
+}
+
+static char *xstrdup(const char *s)
+{
+    char *d = strdup(s);
+    if (!d)
     {
-        setvbuf(stdout, NULL, _IONBF, 0);
+        perror("strdup failed");
+        exit(2);
     }
+    return d;
+}
 
-    int elffd;
-    if ((elffd = open(argv[3], O_RDONLY)) == -1)
+// Timings are stored one test per line as
+// "filename:line\tcycles\twall_us\tname".
+static void load_timings(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return;
+
+    size_t *sorted = malloc(tests_n * sizeof(*sorted));
+    if (!sorted)
     {
-        perror("open elffd failed");
+        perror("malloc sorted failed");
         exit(2);
     }
+    for (size_t i = 0; i < tests_n; i++)
+        sorted[i] = i;
+    qsort(sorted, tests_n, sizeof(*sorted), compare_test_indices);
 
-    struct stat elfst;
-    if (fstat(elffd, &elfst) == -1)
+    char line[1024];
+    while (fgets(line, sizeof(line), f))
     {
-        perror("stat elffd failed");
-        exit(2);
+        char filename[512], name[512];
+        unsigned source_line;
+        unsigned long long cycles, wall_us;
+        line[strcspn(line, "\n")] = '\0';
+        if (sscanf(line, "%511[^\t]\t%llu\t%llu\t%511[^\n]", filename, &cycles, &wall_us, name) != 4)
+            continue;
+        char *colon = strrchr(filename, ':');
+        if (!colon || sscanf(colon + 1, "%u", &source_line) != 1)
+            continue;
+        *colon = '\0';
+
+        size_t lo = 0, hi = tests_n;
+        struct TestInfo *test = NULL;
+        while (lo < hi)
+        {
+            size_t mi = lo + (hi - lo) / 2;
+            int c = compare_tests(&tests[sorted[mi]], filename, source_line, name);
+            if (c < 0)
+                lo = mi + 1;
+            else if (c > 0)
+                hi = mi;
+            else
+            {
+                test = &tests[sorted[mi]];
+                break;
+            }
+        }
+
+        if (test)
+        {
+            test->measured = true;
+            test->cycles = cycles;
+            test->wall_us = wall_us;
+        }
+        else
+        {
+            char **timings = realloc(unmatched_timings, (unmatched_timings_n + 1) * sizeof(*unmatched_timings));
+            if (!timings)
+            {
+                perror("realloc unmatched_timings failed");
+                exit(2);
+            }
+            unmatched_timings = timings;
+            unmatched_timings[unmatched_timings_n++] = xstrdup(line);
+        }
     }
 
-    void *elf;
-    if ((elf = mmap(NULL, elfst.st_size, PROT_READ, MAP_PRIVATE, elffd, 0)) == MAP_FAILED)
+    free(sorted);
+    fclose(f);
+}
+
+static void save_timings(const char *path)
+{
+    char tmp_path[FILENAME_MAX];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *f = fopen(tmp_path, "w");
+    if (!f)
     {
-        perror("mmap elffd failed");
-        exit(2);
+        perror("fopen timings failed");
+        return;
+    }
+    for (size_t i = 0; i < tests_n; i++)
+    {
+        if (tests[i].measured)
+            fprintf(f, "%s:%u\t%llu\t%llu\t%s\n", tests[i].filename, tests[i].source_line, (unsigned long long)tests[i].cycles, (unsigned long long)tests[i].wall_us, tests[i].name);
     }
+    for (size_t i = 0; i < unmatched_timings_n; i++)
+        fprintf(f, "%s\n", unmatched_timings[i]);
+    if (fclose(f) != 0 || rename(tmp_path, path) == -1)
+        perror("write timings failed");
+}
 
-    build_symbol_table(elf);
+static int compare_ranges_by_cost(const void *a, const void *b)
+{
+    const struct TestRange *ra = a, *rb = b;
+    if (ra->cost > rb->cost)
+        return -1;
+    else if (ra->cost < rb->cost)
+        return 1;
+    else
+        return ra->start < rb->start ? -1 : 1;
+}
 
-    nrunners = 1;
-    const char *makeflags = getenv("MAKEFLAGS");
-    if (makeflags)
+// Splits the selected tests into contiguous ranges of roughly
+// 1/(4*nrunners) of the total measured cost, and sorts them
+// longest-first. Tests without a timing are assumed to cost the mean.
+static void plan_test_ranges(void)
+{
+    uint64_t measured_cost = 0;
+    size_t measured_n = 0;
+    for (size_t i = 0; i < tests_n; i++)
     {
-        int e;
-        regex_t preg;
-        regmatch_t pmatch[4];
-        if ((e = regcomp(&preg, "(^| )-j([0-9]*)($| )", REG_EXTENDED)) != 0)
+        if (tests[i].selected && tests[i].measured)
         {
-            char errbuf[256];
-            regerror(e, &preg, errbuf, sizeof(errbuf));
-            fprintf(stderr, "regcomp failed: '%s'\n", errbuf);
-            exit(2);
-        }
-        if (regexec(&preg, makeflags, ARRAY_COUNT(pmatch), pmatch, 0) != REG_NOMATCH)
-        {
-            if (pmatch[2].rm_so == pmatch[2].rm_eo)
-                nrunners = sysconf(_SC_NPROCESSORS_ONLN);
-            else
-                sscanf(makeflags + pmatch[2].rm_so, "%d", &nrunners);
+            measured_cost += tests[i].cycles;
+            measured_n++;
         }
-        regfree(&preg);
     }
-    if (nrunners > MAX_PROCESSES)
-        nrunners = MAX_PROCESSES;
-    runners_digits = ceil(log10(nrunners));
-    runners = calloc(nrunners, sizeof(*runners));
-    if (!runners)
+    if (measured_n == 0)
+        return;
+
+    uint64_t mean_cost = measured_cost / measured_n;
+    uint64_t total_cost = 0;
+    for (size_t i = 0; i < tests_n; i++)
     {
-        perror("calloc runners failed");
+        if (tests[i].selected)
+            total_cost += tests[i].measured ? tests[i].cycles : mean_cost;
+    }
+    uint64_t target_cost = total_cost / (4 * nrunners);
+
+    test_ranges = malloc(tests_n * sizeof(*test_ranges));
+    if (!test_ranges)
+    {
+        perror("malloc test_ranges failed");
         exit(2);
     }
-    for (int i = 0; i < nrunners; i++)
+    struct TestRange *range = NULL;
+    for (size_t i = 0; i < tests_n; i++)
     {
-        runners[i].input_buffer_capacity = 4096;
-        runners[i].input_buffer = malloc(runners[i].input_buffer_capacity);
-        runners[i].output_buffer_capacity = 4096;
-        runners[i].output_buffer = malloc(runners[i].output_buffer_capacity);
-        strcpy(runners[i].test_name, "WAITING...");
-        if (tty)
-            fprintf(stdout, "[%0*d] %s\n", runners_digits, i, runners[i].test_name);
+        // The ROM would run cached tests inside a range.
+        if (tests[i].cached)
+            range = NULL;
+        if (!tests[i].selected)
+            continue;
+        if (!range)
+        {
+            range = &test_ranges[test_ranges_n++];
+            range->start = i;
+            range->cost = 0;
+        }
+        range->cost += tests[i].measured ? tests[i].cycles : mean_cost;
+        range->end = i + 1;
+        if (range->cost >= target_cost)
+            range = NULL;
     }
-    fflush(stdout);
-    atexit(unlink_roms);
-    signal(SIGINT, exit2);
-    signal(SIGTERM, exit2);
+    qsort(test_ranges, test_ranges_n, sizeof(*test_ranges), compare_ranges_by_cost);
+}
 
-    // Start test runners.
-    pid_t parent_pid = getpid();
-    for (int i = 0; i < nrunners; i++)
+// Without timings this falls back to guided self-scheduling: each range
+// holds 1/(2*nrunners) of the remaining selected tests, so early ranges
+// amortize the cost of starting mgba-rom-test and late ranges shrink to
+// single tests which idle runners pick up while the slow tests finish.
+static bool next_test_range(size_t *range_start, size_t *range_end)
+{
+    if (test_ranges_n > 0)
+    {
+        if (next_test_range_i == test_ranges_n)
+            return false;
+        *range_start = test_ranges[next_test_range_i].start;
+        *range_end = test_ranges[next_test_range_i].end;
+        next_test_range_i++;
+        return true;
+    }
+
+    while (next_test < tests_n && !tests[next_test].selected)
+        next_test++;
+    if (next_test == tests_n)
+        return false;
+
+    size_t chunk = (tests_selected_remaining + 2 * nrunners - 1) / (2 * nrunners);
+    *range_start = next_test;
+    while (next_test < tests_n && chunk > 0 && !tests[next_test].cached)
     {
-        int pipefds[2];
-        if (pipe(pipefds) == -1)
+        if (tests[next_test].selected)
         {
-            perror("pipe failed");
-            exit(2);
+            chunk--;
+            tests_selected_remaining--;
         }
-        pid_t pid = fork();
-        if (pid == -1) {
-            perror("fork mgba-rom-test failed");
-            exit(2);
-        } else if (pid == 0) {
-            #ifndef __APPLE__
-            if (prctl(PR_SET_PDEATHSIG, SIGTERM) == -1)
-            {
-                perror("prctl failed");
-                _exit(2);
-            }
-            #endif
-            if (getppid() != parent_pid) // Parent died.
-            {
-                _exit(2);
-            }
-            if (close(pipefds[0]) == -1)
-            {
-                perror("close pipefds[0] failed");
-                _exit(2);
-            }
-            if (dup2(pipefds[1], STDOUT_FILENO) == -1)
-            {
-                perror("dup2 stdout failed");
-                _exit(2);
-            }
-            if (close(pipefds[1]) == -1)
+        next_test++;
+    }
+    *range_end = next_test;
+    return true;
+}
+
+static uint64_t fnv1a(const void *data, size_t size, uint64_t hash)
+{
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+#define FNV1A_INIT 0xcbf29ce484222325ULL
+
+static char *read_file(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = malloc(n > 0 ? n : 1);
+    if (!data || fread(data, 1, n, f) != (size_t)n)
+    {
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = n;
+    return data;
+}
+
+static void add_object(const char *path)
+{
+    size_t size;
+    char *data = read_file(path, &size);
+    if (!data)
+        return;
+    if (size < sizeof(Elf32_Ehdr) || memcmp(data, ELFMAG, 4) != 0)
+    {
+        free(data);
+        return;
+    }
+
+    if (objects_n % 256 == 0)
+    {
+        objects = realloc(objects, (objects_n + 256) * sizeof(*objects));
+        if (!objects)
+        {
+            perror("realloc objects failed");
+            exit(2);
+        }
+    }
+    struct Object *object = &objects[objects_n];
+    memset(object, 0, sizeof(*object));
+    object->path = xstrdup(path);
+    object->data = data;
+    object->hash = fnv1a(data, size, FNV1A_INIT);
+
+    // Collect the symbols which this object defines.
+    const Elf32_Ehdr *ehdr = (Elf32_Ehdr *)data;
+    const Elf32_Shdr *shdrs = (Elf32_Shdr *)(data + ehdr->e_shoff);
+    for (int i = 0; i < ehdr->e_shnum; i++)
+    {
+        if (shdrs[i].sh_type != SHT_SYMTAB)
+            continue;
+        const Elf32_Sym *symtab = (Elf32_Sym *)(data + shdrs[i].sh_offset);
+        const char *strtab = data + shdrs[shdrs[i].sh_link].sh_offset;
+        for (int j = 0; j < shdrs[i].sh_size / shdrs[i].sh_entsize; j++)
+        {
+            int bind = ELF32_ST_BIND(symtab[j].st_info);
+            if (symtab[j].st_name == 0 || symtab[j].st_shndx == SHN_UNDEF)
+                continue;
+            if (bind != STB_GLOBAL && bind != STB_WEAK)
+                continue;
+            if (object_symbols_n % 4096 == 0)
             {
-                perror("close pipefds[1] failed");
-                _exit(2);
+                object_symbols = realloc(object_symbols, (object_symbols_n + 4096) * sizeof(*object_symbols));
+                if (!object_symbols)
+                {
+                    perror("realloc object_symbols failed");
+                    exit(2);
+                }
             }
-            char rom_path[FILENAME_MAX];
-            sprintf(rom_path, "/tmp/mgba-rom-test-hydra-%05d", getpid());
-            int tmpfd;
-            if ((tmpfd = open(rom_path, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)) == -1)
+            object_symbols[object_symbols_n].name = strtab + symtab[j].st_name;
+            object_symbols[object_symbols_n].object = objects_n;
+            object_symbols_n++;
+        }
+    }
+
+    objects_n++;
+}
+
+static void add_objects(const char *dir_path)
+{
+    DIR *dir = opendir(dir_path);
+    if (!dir)
+        return;
+    struct dirent *entry;
+    while ((entry = readdir(dir)))
+    {
+        char path[FILENAME_MAX];
+        struct stat st;
+        size_t len = strlen(entry->d_name);
+        if (entry->d_name[0] == '.')
+            continue;
+        snprintf(path, sizeof(path), "%s/%s", dir_path, entry->d_name);
+        if (lstat(path, &st) == -1)
+            continue;
+        if (S_ISDIR(st.st_mode))
+            add_objects(path);
+        else if (S_ISREG(st.st_mode) && len > 2 && strcmp(entry->d_name + len - 2, ".o") == 0)
+            add_object(path);
+    }
+    closedir(dir);
+}
+
+static int compare_object_symbols(const void *a, const void *b)
+{
+    const struct ObjectSymbol *sa = a, *sb = b;
+    return strcmp(sa->name, sb->name);
+}
+
+// Links each object to the objects defining the symbols it uses.
+static void resolve_object_deps(void)
+{
+    qsort(object_symbols, object_symbols_n, sizeof(*object_symbols), compare_object_symbols);
+    for (size_t k = 0; k < objects_n; k++)
+    {
+        const char *data = objects[k].data;
+        const Elf32_Ehdr *ehdr = (Elf32_Ehdr *)data;
+        const Elf32_Shdr *shdrs = (Elf32_Shdr *)(data + ehdr->e_shoff);
+        for (int i = 0; i < ehdr->e_shnum; i++)
+        {
+            if (shdrs[i].sh_type != SHT_SYMTAB)
+                continue;
+            const Elf32_Sym *symtab = (Elf32_Sym *)(data + shdrs[i].sh_offset);
+            const char *strtab = data + shdrs[shdrs[i].sh_link].sh_offset;
+            size_t symtab_n = shdrs[i].sh_size / shdrs[i].sh_entsize;
+            objects[k].deps = malloc(symtab_n * sizeof(*objects[k].deps));
+            if (!objects[k].deps)
             {
-                perror("open tmpfd failed");
-                _exit(2);
+                perror("malloc deps failed");
+                exit(2);
             }
-            if ((write(tmpfd, elf, elfst.st_size)) == -1)
+            for (int j = 0; j < symtab_n; j++)
             {
-                perror("write tmpfd failed");
-                _exit(2);
+                if (symtab[j].st_name == 0 || symtab[j].st_shndx != SHN_UNDEF)
+                    continue;
+                struct ObjectSymbol key = { strtab + symtab[j].st_name, 0 };
+                const struct ObjectSymbol *symbol = bsearch(&key, object_symbols, object_symbols_n, sizeof(*object_symbols), compare_object_symbols);
+                if (symbol)
+                    objects[k].deps[objects[k].deps_n++] = symbol->object;
             }
-            pid_t patchelfpid = fork();
-            if (patchelfpid == -1)
+            break;
+        }
+    }
+}
+
+static uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Order-independent hash of every object reachable from 'k'.
+static uint64_t hash_object_closure(size_t k)
+{
+    uint64_t hash = 0;
+    size_t *stack = malloc(objects_n * sizeof(*stack));
+    size_t stack_n = 0;
+    if (!stack)
+    {
+        perror("malloc stack failed");
+        exit(2);
+    }
+    object_visit++;
+    objects[k].visited = object_visit;
+    stack[stack_n++] = k;
+    while (stack_n > 0)
+    {
+        struct Object *object = &objects[stack[--stack_n]];
+        hash += mix64(object->hash);
+        for (size_t i = 0; i < object->deps_n; i++)
+        {
+            if (objects[object->deps[i]].visited != object_visit)
             {
-                perror("fork patchelf failed");
-                _exit(2);
+                objects[object->deps[i]].visited = object_visit;
+                stack[stack_n++] = object->deps[i];
             }
-            else if (patchelfpid == 0)
+        }
+    }
+    free(stack);
+    return hash;
+}
+
+static size_t find_object(const char *path)
+{
+    for (size_t k = 0; k < objects_n; k++)
+    {
+        if (strcmp(objects[k].path, path) == 0)
+            return k;
+    }
+    return objects_n;
+}
+
+// Returns the key of the test file whose tests start at 'start', or 0
+// if its object could not be found.
+static uint64_t test_file_key(const char *obj_dir, size_t start, uint64_t ld_script_hash)
+{
+    char path[FILENAME_MAX];
+    const char *filename = tests[start].filename;
+    size_t len = strlen(filename);
+    if (len < 2 || strcmp(filename + len - 2, ".c") != 0)
+        return 0;
+    snprintf(path, sizeof(path), "%s/%.*s.o", obj_dir, (int)(len - 2), filename);
+    size_t k = find_object(path);
+    if (k == objects_n)
+        return 0;
+    return mix64(hash_object_closure(k) ^ ld_script_hash) | 1;
+}
+
+static size_t test_file_end(size_t start)
+{
+    size_t end = start;
+    while (end < tests_n && strcmp(tests[end].filename, tests[start].filename) == 0)
+        end++;
+    return end;
+}
+
+static void cache_path(char *path, size_t size, const char *obj_dir)
+{
+    snprintf(path, size, "%s/test_results.cache", obj_dir);
+}
+
+struct CachedTestFile {
+    const char *filename;
+    uint64_t key;
+    char *results;
+};
+
+static int compare_cached_test_files(const void *a, const void *b)
+{
+    const struct CachedTestFile *ca = a, *cb = b;
+    return strcmp(ca->filename, cb->filename);
+}
+
+// The cache holds one test file per line as "filename\tkey\tresults",
+// where results is one P/K/T character for each test in the file.
+// Cached files are deselected and their results are replayed.
+static void load_test_results_cache(const char *obj_dir, bool tty)
+{
+    char path[FILENAME_MAX];
+    size_t ld_script_size;
+    uint64_t ld_script_hash = FNV1A_INIT;
+    snprintf(path, sizeof(path), "%s/ld_script_test.ld", obj_dir);
+    char *ld_script = read_file(path, &ld_script_size);
+    if (ld_script)
+    {
+        ld_script_hash = fnv1a(ld_script, ld_script_size, ld_script_hash);
+        free(ld_script);
+    }
+
+    add_objects(obj_dir);
+    resolve_object_deps();
+
+    cache_path(path, sizeof(path), obj_dir);
+    FILE *f = fopen(path, "r");
+    struct CachedTestFile *cached = NULL;
+    size_t cached_n = 0;
+    char line[4096];
+    while (f && fgets(line, sizeof(line), f))
+    {
+        char filename[512], results[2048];
+        unsigned long long key;
+        if (sscanf(line, "%511[^\t]\t%llx\t%2047s", filename, &key, results) != 3)
+            continue;
+        cached = realloc(cached, (cached_n + 1) * sizeof(*cached));
+        if (!cached)
+        {
+            perror("realloc cached failed");
+            exit(2);
+        }
+        cached[cached_n].filename = xstrdup(filename);
+        cached[cached_n].key = key;
+        cached[cached_n].results = xstrdup(results);
+        cached_n++;
+    }
+    if (f)
+        fclose(f);
+    qsort(cached, cached_n, sizeof(*cached), compare_cached_test_files);
+
+    for (size_t start = 0; start < tests_n; start = test_file_end(start))
+    {
+        size_t end = test_file_end(start);
+        uint64_t key = test_file_key(obj_dir, start, ld_script_hash);
+        for (size_t i = start; i < end; i++)
+            tests[i].file_key = key;
+        if (key == 0)
+            continue;
+
+        struct CachedTestFile search = { tests[start].filename, 0, NULL };
+        const struct CachedTestFile *entry = bsearch(&search, cached, cached_n, sizeof(*cached), compare_cached_test_files);
+        if (!entry || entry->key != key)
+            continue;
+
+        // Check the results cover every test in the file.
+        size_t r = 0;
+        for (size_t i = start; i < end; i++)
+        {
+            if (strncmp(tests[i].name, "ASSUMPTIONS: ", strlen("ASSUMPTIONS: ")) != 0)
+                r++;
+        }
+        if (strlen(entry->results) != r)
+            continue;
+
+        r = 0;
+        for (size_t i = start; i < end; i++)
+        {
+            tests[i].cached = true;
+            if (strncmp(tests[i].name, "ASSUMPTIONS: ", strlen("ASSUMPTIONS: ")) == 0)
+                continue;
+            tests[i].result = entry->results[r++];
+            if (tests[i].selected)
             {
-                char n_arg[5], i_arg[5];
-                snprintf(n_arg, sizeof(n_arg), "\\x%02x", nrunners);
-                snprintf(i_arg, sizeof(i_arg), "\\x%02x", i);
-                if (execlp("tools/patchelf/patchelf", "tools/patchelf/patchelf", rom_path, "gTestRunnerN", n_arg, "gTestRunnerI", i_arg, NULL) == -1)
+                tests[i].selected = false;
+                tests_selected_remaining--;
+                switch (tests[i].result)
                 {
-                    perror("execlp patchelf failed");
-                    _exit(2);
+                case 'P': cached_passes++; break;
+                case 'K': cached_knownFails++; break;
+                case 'T': cached_todos++; break;
                 }
+                if (!tty)
+                    fprintf(stdout, "[%*s] %s: CACHED\n", runners_digits, "-", tests[i].name);
             }
+        }
+    }
+
+    for (size_t i = 0; i < cached_n; i++)
+    {
+        free((char *)cached[i].filename);
+        free(cached[i].results);
+    }
+    free(cached);
+}
+
+// A file is cached if each of its tests either was cached, or ran in
+// this process with a passing result.
+static void save_test_results_cache(const char *obj_dir)
+{
+    char path[FILENAME_MAX], tmp_path[FILENAME_MAX];
+    cache_path(path, sizeof(path), obj_dir);
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *f = fopen(tmp_path, "w");
+    if (!f)
+    {
+        perror("fopen test_results.cache failed");
+        return;
+    }
+    for (size_t start = 0; start < tests_n; start = test_file_end(start))
+    {
+        size_t end = test_file_end(start);
+        uint64_t key = tests[start].file_key;
+        char results[2048];
+        size_t r = 0;
+        bool cacheable = key != 0;
+        for (size_t i = start; i < end && cacheable; i++)
+        {
+            if (strncmp(tests[i].name, "ASSUMPTIONS: ", strlen("ASSUMPTIONS: ")) == 0)
+                continue;
+            if (r + 1 >= sizeof(results)
+             || (tests[i].result != 'P' && tests[i].result != 'K' && tests[i].result != 'T'))
+                cacheable = false;
             else
+                results[r++] = tests[i].result;
+        }
+        results[r] = '\0';
+        if (cacheable && r > 0)
+            fprintf(f, "%s\t%llx\t%s\n", tests[start].filename, (unsigned long long)key, results);
+    }
+    if (fclose(f) != 0 || rename(tmp_path, path) == -1)
+        perror("write test_results.cache failed");
+}
+
+static void format_u32_arg(char *arg, uint32_t value)
+{
+    sprintf(arg, "\\x%02x\\x%02x\\x%02x\\x%02x", value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24);
+}
+
+// Starts a mgba-rom-test process in runner slot 'i' which runs the
+// tests in [range_start, range_end).
+static void spawn_runner(int i, size_t range_start, size_t range_end)
+{
+    struct Runner *runner = &runners[i];
+    int pipefds[2];
+    if (pipe(pipefds) == -1)
+    {
+        perror("pipe failed");
+        exit(2);
+    }
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork mgba-rom-test failed");
+        exit(2);
+    } else if (pid == 0) {
+        #ifndef __APPLE__
+        if (prctl(PR_SET_PDEATHSIG, SIGTERM) == -1)
+        {
+            perror("prctl failed");
+            _exit(2);
+        }
+        #endif
+        if (getppid() != parent_pid) // Parent died.
+        {
+            _exit(2);
+        }
+        if (close(pipefds[0]) == -1)
+        {
+            perror("close pipefds[0] failed");
+            _exit(2);
+        }
+        if (dup2(pipefds[1], STDOUT_FILENO) == -1)
+        {
+            perror("dup2 stdout failed");
+            _exit(2);
+        }
+        if (close(pipefds[1]) == -1)
+        {
+            perror("close pipefds[1] failed");
+            _exit(2);
+        }
+        char rom_path[FILENAME_MAX];
+        sprintf(rom_path, "/tmp/mgba-rom-test-hydra-%05d", getpid());
+        int tmpfd;
+        if ((tmpfd = open(rom_path, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)) == -1)
+        {
+            perror("open tmpfd failed");
+            _exit(2);
+        }
+        if ((write(tmpfd, elf, elf_size)) == -1)
+        {
+            perror("write tmpfd failed");
+            _exit(2);
+        }
+        pid_t patchelfpid = fork();
+        if (patchelfpid == -1)
+        {
+            perror("fork patchelf failed");
+            _exit(2);
+        }
+        else if (patchelfpid == 0)
+        {
+            // With a test table every process runs its range alone,
+            // otherwise fall back to the static partition in the ROM.
+            char n_arg[5], i_arg[5], start_arg[17], end_arg[17];
+            snprintf(n_arg, sizeof(n_arg), "\\x%02x", tests_n > 0 ? 1 : nrunners);
+            snprintf(i_arg, sizeof(i_arg), "\\x%02x", tests_n > 0 ? 0 : i);
+            format_u32_arg(start_arg, range_start);
+            format_u32_arg(end_arg, range_end);
+            if (execlp("tools/patchelf/patchelf", "tools/patchelf/patchelf", rom_path, "gTestRunnerN", n_arg, "gTestRunnerI", i_arg, "gTestRunnerRangeStart", start_arg, "gTestRunnerRangeEnd", end_arg, NULL) == -1)
             {
-                int wstatus;
-                if (waitpid(patchelfpid, &wstatus, 0) == -1)
-                {
-                    perror("waitpid patchelfpid failed");
-                    _exit(2);
-                }
-                if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
-                {
-                    fprintf(stderr, "patchelf exited with an error\n");
-                    _exit(2);
-                }
+                perror("execlp patchelf failed");
+                _exit(2);
             }
-#ifdef __APPLE__
-            pid_t objcopypid = fork();
-            if (objcopypid == -1)
+        }
+        else
+        {
+            int wstatus;
+            if (waitpid(patchelfpid, &wstatus, 0) == -1)
             {
-                perror("fork objcopy failed");
+                perror("waitpid patchelfpid failed");
                 _exit(2);
             }
-            else if (objcopypid == 0)
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
             {
-                if (execlp(argv[2], argv[2], "-O", "binary", rom_path, rom_path, NULL) == -1)
-                {
-                    perror("execlp objcopy failed");
-                    _exit(2);
-                }
+                fprintf(stderr, "patchelf exited with an error\n");
+                _exit(2);
             }
-            else
+        }
+#ifdef __APPLE__
+        pid_t objcopypid = fork();
+        if (objcopypid == -1)
+        {
+            perror("fork objcopy failed");
+            _exit(2);
+        }
+        else if (objcopypid == 0)
+        {
+            if (execlp(objcopy_path, objcopy_path, "-O", "binary", rom_path, rom_path, NULL) == -1)
             {
-                int wstatus;
-                if (waitpid(objcopypid, &wstatus, 0) == -1)
-                {
-                    perror("waitpid objcopy failed");
-                    _exit(2);
-                }
-                if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
-                {
-                    fprintf(stderr, "objcopy exited with an error\n");
-                    _exit(2);
-                }
+                perror("execlp objcopy failed");
+                _exit(2);
             }
-#endif
-            // stdbuf is required because otherwise mgba never flushes
-            // stdout.
-            if (execlp("stdbuf", "stdbuf", "-oL", argv[1], "-l15", "-ClogLevel.gba.dma=16", "-Rr0", rom_path, NULL) == -1)
+        }
+        else
+        {
+            int wstatus;
+            if (waitpid(objcopypid, &wstatus, 0) == -1)
             {
-                perror("execl stdbuf mgba-rom-test failed");
+                perror("waitpid objcopy failed");
                 _exit(2);
             }
-        } else {
-            runners[i].pid = pid;
-            sprintf(runners[i].rom_path, "/tmp/mgba-rom-test-hydra-%05d", runners[i].pid);
-            runners[i].outfd = pipefds[0];
-            if (close(pipefds[1]) == -1)
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
             {
-                perror("close pipefds[1] failed");
-                exit(2);
+                fprintf(stderr, "objcopy exited with an error\n");
+                _exit(2);
             }
         }
+#endif
+        // stdbuf is required because otherwise mgba never flushes
+        // stdout.
+        if (execlp("stdbuf", "stdbuf", "-oL", mgba_rom_test_path, "-l15", "-ClogLevel.gba.dma=16", "-Rr0", rom_path, NULL) == -1)
+        {
+            perror("execl stdbuf mgba-rom-test failed");
+            _exit(2);
+        }
+    } else {
+        runner->pid = pid;
+        runner->test_ticks_valid = false;
+        clock_gettime(CLOCK_MONOTONIC, &runner->test_start);
+        sprintf(runner->rom_path, "/tmp/mgba-rom-test-hydra-%05d", runner->pid);
+        runner->outfd = pipefds[0];
+        if (close(pipefds[1]) == -1)
+        {
+            perror("close pipefds[1] failed");
+            exit(2);
+        }
+    }
+}
+
+// Lists the tests which used the most heap, with the smallest largest free
+// block and the worst fragmentation they saw.
+static void print_heap_summary(void)
+{
+    size_t listed_i[MAX_HEAP_TESTS_TO_LIST];
+    size_t n = 0;
+
+    while (n < MAX_HEAP_TESTS_TO_LIST)
+    {
+        size_t best = tests_n;
+        for (size_t i = 0; i < tests_n; i++)
+        {
+            bool already_listed = false;
+            if (!tests[i].heap_measured)
+                continue;
+            for (size_t j = 0; j < n; j++)
+                already_listed |= listed_i[j] == i;
+            if (!already_listed && (best == tests_n || tests[i].heap_peak > tests[best].heap_peak))
+                best = i;
+        }
+        if (best == tests_n)
+            break;
+        listed_i[n++] = best;
+    }
+
+    if (n == 0)
+        return;
+
+    fprintf(stdout, "\n  Most heap used:\n");
+    for (size_t j = 0; j < n; j++)
+    {
+        const struct TestInfo *test = &tests[listed_i[j]];
+        fprintf(stdout, "  - %s:%u - %s: peak %u bytes, largest free %u bytes, %u%% fragmented.\n", test->filename, test->source_line, test->name, test->heap_peak, test->heap_min_largest_free, test->heap_max_fragmentation);
+    }
+}
+
+static const char *profile_symbol_name(uint32_t symbol)
+{
+    if (symbol == symbol_table.symbols_n)
+        return "[unknown]";
+    return symbol_table.symbols[symbol].name;
+}
+
+// Lists the functions which were sampled the most, including samples
+// where they were the caller.
+static void print_profile_summary(void)
+{
+    if (profile_samples == 0)
+        return;
+
+    uint64_t *self = calloc(symbol_table.symbols_n + 1, sizeof(*self));
+    uint64_t *total = calloc(symbol_table.symbols_n + 1, sizeof(*total));
+    if (!self || !total)
+    {
+        perror("calloc profile counts failed");
+        exit(2);
+    }
+    for (size_t i = 0; i < profile_stacks_c; i++)
+    {
+        if (profile_stacks[i].count == 0)
+            continue;
+        self[profile_stacks[i].function] += profile_stacks[i].count;
+        total[profile_stacks[i].function] += profile_stacks[i].count;
+        if (profile_stacks[i].caller != symbol_table.symbols_n)
+            total[profile_stacks[i].caller] += profile_stacks[i].count;
+    }
+
+    fprintf(stdout, "\n  Most sampled functions (self, with callees), %llu samples:\n", (unsigned long long)profile_samples);
+    for (int n = 0; n < MAX_PROFILE_FUNCTIONS_TO_LIST; n++)
+    {
+        size_t best = symbol_table.symbols_n + 1;
+        for (size_t i = 0; i <= symbol_table.symbols_n; i++)
+        {
+            if (self[i] > 0 && (best > symbol_table.symbols_n || self[i] > self[best]))
+                best = i;
+        }
+        if (best > symbol_table.symbols_n)
+            break;
+        fprintf(stdout, "  - %5.1f%% %5.1f%% %s\n", 100.0 * self[best] / profile_samples, 100.0 * total[best] / profile_samples, profile_symbol_name(best));
+        self[best] = 0;
+    }
+
+    free(self);
+    free(total);
+}
+
+static void save_profile(const char *timings_path)
+{
+    char path[FILENAME_MAX];
+    const char *slash = timings_path ? strrchr(timings_path, '/') : NULL;
+    if (slash)
+        snprintf(path, sizeof(path), "%.*s/test_profile.folded", (int)(slash - timings_path), timings_path);
+    else
+        snprintf(path, sizeof(path), "test_profile.folded");
+
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        perror("fopen profile failed");
+        return;
+    }
+    for (size_t i = 0; i < profile_stacks_c; i++)
+    {
+        const struct ProfileStack *stack = &profile_stacks[i];
+        if (stack->count == 0)
+            continue;
+        if (stack->caller != symbol_table.symbols_n)
+            fprintf(f, "%s;", profile_symbol_name(stack->caller));
+        fprintf(f, "%s %llu\n", profile_symbol_name(stack->function), (unsigned long long)stack->count);
+    }
+    if (fclose(f) != 0)
+        perror("write profile failed");
+    else
+        fprintf(stdout, "Profile saved to %s.\n\n", path);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage %s mgba-rom-test objcopy rom [timings [obj_dir]]\n", argv[0]);
+        exit(2);
+    }
+
+    bool tty = isatty(STDOUT_FILENO);
+    if (!tty)
+    {
+        const char *v = getenv("MAKE_TERMOUT");
+        tty = v && v[0] == '\0';
+    }
+
+    if (tty)
+    {
+        char *stdout_buffer = malloc(64 * 1024);
+        if (!stdout_buffer)
+        {
+            perror("malloc stdout_buffer failed");
+            exit(2);
+        }
+        setvbuf(stdout, stdout_buffer, _IOFBF, 64 * 1024);
+    }
+    else
+    {
+        setvbuf(stdout, NULL, _IONBF, 0);
+    }
+
+    int elffd;
+    if ((elffd = open(argv[3], O_RDONLY)) == -1)
+    {
+        perror("open elffd failed");
+        exit(2);
+    }
+
+    struct stat elfst;
+    if (fstat(elffd, &elfst) == -1)
+    {
+        perror("stat elffd failed");
+        exit(2);
+    }
+
+    if ((elf = mmap(NULL, elfst.st_size, PROT_READ, MAP_PRIVATE, elffd, 0)) == MAP_FAILED)
+    {
+        perror("mmap elffd failed");
+        exit(2);
+    }
+    elf_size = elfst.st_size;
+    mgba_rom_test_path = argv[1];
+    objcopy_path = argv[2];
+
+    build_symbol_table(elf);
+    build_test_table();
+
+    nrunners = 1;
+    const char *makeflags = getenv("MAKEFLAGS");
+    if (makeflags)
+    {
+        int e;
+        regex_t preg;
+        regmatch_t pmatch[4];
+        if ((e = regcomp(&preg, "(^| )-j([0-9]*)($| )", REG_EXTENDED)) != 0)
+        {
+            char errbuf[256];
+            regerror(e, &preg, errbuf, sizeof(errbuf));
+            fprintf(stderr, "regcomp failed: '%s'\n", errbuf);
+            exit(2);
+        }
+        if (regexec(&preg, makeflags, ARRAY_COUNT(pmatch), pmatch, 0) != REG_NOMATCH)
+        {
+            if (pmatch[2].rm_so == pmatch[2].rm_eo)
+                nrunners = sysconf(_SC_NPROCESSORS_ONLN);
+            else
+                sscanf(makeflags + pmatch[2].rm_so, "%d", &nrunners);
+        }
+        regfree(&preg);
+    }
+    if (nrunners > MAX_PROCESSES)
+        nrunners = MAX_PROCESSES;
+
+    const char *timings_path = argc > 4 && argv[4][0] ? argv[4] : NULL;
+    const char *obj_dir = argc > 5 ? argv[5] : NULL;
+    if (obj_dir && tests_n > 0)
+        load_test_results_cache(obj_dir, tty);
+    if (timings_path && tests_n > 0)
+    {
+        load_timings(timings_path);
+        plan_test_ranges();
+    }
+    runners_digits = ceil(log10(nrunners));
+    runners = calloc(nrunners, sizeof(*runners));
+    if (!runners)
+    {
+        perror("calloc runners failed");
+        exit(2);
+    }
+    for (int i = 0; i < nrunners; i++)
+    {
+        runners[i].input_buffer_capacity = 4096;
+        runners[i].input_buffer = malloc(runners[i].input_buffer_capacity);
+        runners[i].output_buffer_capacity = 4096;
+        runners[i].output_buffer = malloc(runners[i].output_buffer_capacity);
+        strcpy(runners[i].test_name, "WAITING...");
+        if (tty)
+            fprintf(stdout, "[%0*d] %s\n", runners_digits, i, runners[i].test_name);
+    }
+    fflush(stdout);
+    atexit(unlink_roms);
+    signal(SIGINT, exit2);
+    signal(SIGTERM, exit2);
+
+    // Start test runners.
+    parent_pid = getpid();
+    int openfds = 0;
+    for (int i = 0; i < nrunners; i++)
+    {
+        size_t range_start = 0, range_end = 0;
+        if (tests_n > 0 && !next_test_range(&range_start, &range_end))
+        {
+            runners[i].outfd = -1;
+            continue;
+        }
+        spawn_runner(i, range_start, range_end);
+        openfds++;
     }
 
     // Process test runner output.
-    int openfds = nrunners;
     struct pollfd *pollfds = calloc(nrunners, sizeof(*pollfds));
     if (!pollfds)
     {
@@ -712,13 +1846,32 @@ int main(int argc, char *argv[])
 
             if (pollfds[i].revents & (POLLERR | POLLHUP))
             {
+                // Drain the pipe so that the last results of the
+                // range are not lost.
+                int n;
+                while ((n = read(pollfds[i].fd, runners[i].input_buffer + runners[i].input_buffer_size, runners[i].input_buffer_capacity - runners[i].input_buffer_size)) > 0)
+                {
+                    runners[i].input_buffer_size += n;
+                    handle_read(i, &runners[i]);
+                }
                 if (close(pollfds[i].fd) == -1)
                 {
                     perror("close pollfds[i] failed");
                     exit(2);
                 }
-                runners[i].outfd = pollfds[i].fd = -pollfds[i].fd;
-                openfds--;
+                reap_runner(&runners[i]);
+
+                size_t range_start, range_end;
+                if (tests_n > 0 && next_test_range(&range_start, &range_end))
+                {
+                    spawn_runner(i, range_start, range_end);
+                    pollfds[i].fd = runners[i].outfd;
+                }
+                else
+                {
+                    runners[i].outfd = pollfds[i].fd = -1;
+                    openfds--;
+                }
             }
         }
 
@@ -734,15 +1887,15 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Reap test runners and collate exit codes.
+    // Collate exit codes.
     int exit_code = 0;
-    int passes = 0;
-    int knownFails = 0;
+    int passes = cached_passes;
+    int knownFails = cached_knownFails;
     int knownFailsPassing = 0;
-    int todos = 0;
+    int todos = cached_todos;
     int assumptionFails = 0;
     int fails = 0;
-    int results = 0;
+    int results = cached_passes + cached_knownFails + cached_todos;
 
     char failed_TestNames[MAX_SUMMARY_TESTS_TO_LIST * MAX_PROCESSES][MAX_TEST_LIST_BUFFER_LENGTH];
     char failed_TestFilenameLine[MAX_SUMMARY_TESTS_TO_LIST * MAX_PROCESSES][MAX_TEST_LIST_BUFFER_LENGTH];
@@ -755,16 +1908,8 @@ int main(int argc, char *argv[])
 
     for (int i = 0; i < nrunners; i++)
     {
-        int wstatus;
-        if (waitpid(runners[i].pid, &wstatus, 0) == -1)
-        {
-            perror("waitpid runners[i] failed");
-            exit(2);
-        }
-        if (runners[i].output_buffer_size > 0)
-            fwrite(runners[i].output_buffer, 1, runners[i].output_buffer_size, stdout);
-        if (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) > exit_code)
-            exit_code = WEXITSTATUS(wstatus);
+        if (runners[i].exit_code > exit_code)
+            exit_code = runners[i].exit_code;
         passes += runners[i].passes;
         knownFails += runners[i].knownFails;
         for (int j = 0; j < runners[i].knownFailsPassing; j++)
@@ -852,6 +1997,9 @@ int main(int argc, char *argv[])
             }
         }
 
+        print_heap_summary();
+        print_profile_summary();
+
         fprintf(stdout, "\n");
         if (fails > 0)
             fprintf(stdout, "- Tests \e[31mFAILED\e[0m :         %d    Add TESTS='X' to run tests with the defined prefix.\n", fails);
@@ -869,5 +2017,14 @@ int main(int argc, char *argv[])
     fprintf(stdout, "\n");
 
     fflush(stdout);
+
+    if (timings_path && tests_n > 0)
+        save_timings(timings_path);
+    if (obj_dir && tests_n > 0)
+        save_test_results_cache(obj_dir);
+    if (profile_samples > 0)
+        save_profile(timings_path);
+    fflush(stdout);
+
     return exit_code;
 }
@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <map>
 #include <stdexcept>
 #include "preproc.h"
 #include "asm_file.h"
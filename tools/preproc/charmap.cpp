@@ -387,9 +387,12 @@ Charmap::Charmap(std::string filename)
         switch (lhs.type)
         {
         case LhsType::Char:
-            if (m_chars.find(lhs.code) != m_chars.end())
+            if (Char(lhs.code).length() != 0)
                 reader.RaiseError("redefining char");
-            m_chars[lhs.code] = sequence;
+            if (lhs.code < kNumDirectChars)
+                m_directChars[lhs.code] = sequence;
+            else
+                m_chars[lhs.code] = sequence;
             break;
         case LhsType::Escape:
             if (m_escapes[lhs.code].length() != 0)
@@ -23,7 +23,7 @@
 
 #include <cstdint>
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 class Charmap
@@ -31,34 +31,43 @@ class Charmap
 public:
     Charmap(std::string filename);
 
-    std::string Char(std::int32_t code)
+    const std::string& Char(std::int32_t code)
     {
+        if (code >= 0 && code < kNumDirectChars)
+            return m_directChars[code];
+
         auto it = m_chars.find(code);
 
         if (it == m_chars.end())
-            return std::string();
+            return m_empty;
 
         return it->second;
     }
 
-    std::string Escape(unsigned char code)
+    const std::string& Escape(unsigned char code)
     {
         return m_escapes[code];
     }
 
-    std::string Constant(std::string identifier)
+    const std::string& Constant(const std::string& identifier)
     {
         auto it = m_constants.find(identifier);
 
         if (it == m_constants.end())
-            return std::string();
+            return m_empty;
 
         return it->second;
     }
 private:
-    std::map<std::int32_t, std::string> m_chars;
+    // Nearly every character in a string literal is ASCII or Latin-1, so those
+    // are looked up by index instead of searching m_chars.
+    static const std::int32_t kNumDirectChars = 256;
+
+    std::string m_directChars[kNumDirectChars];
+    std::unordered_map<std::int32_t, std::string> m_chars;
     std::string m_escapes[128];
-    std::map<std::string, std::string> m_constants;
+    std::unordered_map<std::string, std::string> m_constants;
+    std::string m_empty;
 };
 
 #endif // CHARMAP_H
@@ -140,9 +140,64 @@ const char* GetFileExtension(const char* filename)
     return extension;
 }
 
+void PreprocFile(const char *source, bool isStdin, bool doEnum)
+{
+    const char* extension = GetFileExtension(source);
+
+    if (!extension)
+        FATAL_ERROR("\"%s\" has no file extension.\n", source);
+
+    if ((extension[0] == 's') && extension[1] == 0)
+    {
+        PreprocAsmFile(source, isStdin, doEnum);
+    }
+    else if ((extension[0] == 'c' || extension[0] == 'i') && extension[1] == 0)
+    {
+        if (doEnum)
+            FATAL_ERROR("-e is invalid for C sources\n");
+        PreprocCFile(source, isStdin);
+    }
+    else
+    {
+        FATAL_ERROR("\"%s\" has an unknown file extension of \"%s\".\n", source, extension);
+    }
+}
+
+// Preprocesses every "SRC_FILE OUT_FILE" pair listed in listPath, so the
+// charmap only has to be loaded once for all of them.
+void PreprocBatch(const char *listPath, bool doEnum)
+{
+    FILE *list = std::fopen(listPath, "r");
+
+    if (list == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", listPath);
+
+    char source[kMaxPath];
+    char output[kMaxPath];
+    int count;
+
+    while ((count = std::fscanf(list, "%255s %255s", source, output)) == 2)
+    {
+        if (std::freopen(output, "w", stdout) == NULL)
+            FATAL_ERROR("Failed to open \"%s\" for writing.\n", output);
+
+        PreprocFile(source, false, doEnum);
+        std::fflush(stdout);
+    }
+
+    if (count != EOF)
+        FATAL_ERROR("Odd number of paths in \"%s\".\n", listPath);
+
+    std::fclose(list);
+}
+
 static void UsageAndExit(const char *program)
 {
-    std::fprintf(stderr, "Usage: %s [-i] [-e] SRC_FILE CHARMAP_FILE\nwhere -i denotes if input is from stdin\n      -e enables enum handling\n", program);
+    std::fprintf(stderr, "Usage: %s [-i] [-e] SRC_FILE CHARMAP_FILE\n"
+                         "       %s [-e] -b LIST_FILE CHARMAP_FILE\n"
+                         "where -i denotes if input is from stdin\n"
+                         "      -e enables enum handling\n"
+                         "      -b preprocesses each \"SRC_FILE OUT_FILE\" pair in LIST_FILE\n", program, program);
     std::exit(EXIT_FAILURE);
 }
 
@@ -151,11 +206,13 @@ int main(int argc, char **argv)
     int opt;
     const char *source = NULL;
     const char *charmap = NULL;
+    const char *listPath = NULL;
     bool isStdin = false;
     bool doEnum = false;
 
     /* preproc [-i] [-e] SRC_FILE CHARMAP_FILE */
-    while ((opt = getopt(argc, argv, "ie")) != -1)
+    /* preproc [-e] -b LIST_FILE CHARMAP_FILE */
+    while ((opt = getopt(argc, argv, "ieb:")) != -1)
     {
         switch (opt)
         {
@@ -165,12 +222,25 @@ int main(int argc, char **argv)
         case 'e':
             doEnum = true;
             break;
+        case 'b':
+            listPath = optarg;
+            break;
         default:
             UsageAndExit(argv[0]);
             break;
         }
     }
 
+    if (listPath != NULL)
+    {
+        if (isStdin || optind + 1 != argc)
+            UsageAndExit(argv[0]);
+
+        g_charmap = new Charmap(argv[optind]);
+        PreprocBatch(listPath, doEnum);
+        return 0;
+    }
+
     if (optind + 2 != argc)
         UsageAndExit(argv[0]);
 
@@ -179,25 +249,7 @@ int main(int argc, char **argv)
 
     g_charmap = new Charmap(charmap);
 
-    const char* extension = GetFileExtension(source);
-
-    if (!extension)
-        FATAL_ERROR("\"%s\" has no file extension.\n", argv[1]);
-
-    if ((extension[0] == 's') && extension[1] == 0)
-    {
-        PreprocAsmFile(source, isStdin, doEnum);
-    }
-    else if ((extension[0] == 'c' || extension[0] == 'i') && extension[1] == 0)
-    {
-        if (doEnum)
-            FATAL_ERROR("-e is invalid for C sources\n");
-        PreprocCFile(source, isStdin);
-    }
-    else
-    {
-        FATAL_ERROR("\"%s\" has an unknown file extension of \"%s\".\n", argv[1], extension);
-    }
+    PreprocFile(source, isStdin, doEnum);
 
     return 0;
 }
@@ -27,10 +27,8 @@
 #include "utf8.h"
 
 // Reads a charmap char or escape sequence.
-std::string StringParser::ReadCharOrEscape()
+const std::string& StringParser::ReadCharOrEscape()
 {
-    std::string sequence;
-
     bool isEscape = (m_buffer[m_pos] == '\\');
 
     if (isEscape)
@@ -39,7 +37,7 @@ std::string StringParser::ReadCharOrEscape()
 
         if (m_buffer[m_pos] == '"')
         {
-            sequence = g_charmap->Char('"');
+            const std::string& sequence = g_charmap->Char('"');
 
             if (sequence.length() == 0)
                 RaiseError("no mapping exists for double quote");
@@ -48,7 +46,7 @@ std::string StringParser::ReadCharOrEscape()
         }
         else if (m_buffer[m_pos] == '\\')
         {
-            sequence = g_charmap->Char('\\');
+            const std::string& sequence = g_charmap->Char('\\');
 
             if (sequence.length() == 0)
                 RaiseError("no mapping exists for backslash");
@@ -80,7 +78,7 @@ std::string StringParser::ReadCharOrEscape()
     if (isEscape && code >= 128)
         RaiseError("escapes using non-ASCII characters are invalid");
 
-    sequence = isEscape ? g_charmap->Escape(code) : g_charmap->Char(code);
+    const std::string& sequence = isEscape ? g_charmap->Escape(code) : g_charmap->Char(code);
 
     if (sequence.length() == 0)
     {
@@ -113,7 +111,7 @@ std::string StringParser::ReadBracketedConstants()
             while (IsIdentifierChar(m_buffer[m_pos]))
                 m_pos++;
 
-            std::string sequence = g_charmap->Constant(std::string(&m_buffer[startPos], m_pos - startPos));
+            const std::string& sequence = g_charmap->Constant(std::string(&m_buffer[startPos], m_pos - startPos));
 
             if (sequence.length() == 0)
             {
@@ -181,9 +179,20 @@ int StringParser::ParseString(long srcPos, unsigned char* dest, int& destLength)
 
     while (m_buffer[m_pos] != '"')
     {
-        std::string sequence = (m_buffer[m_pos] == '{') ? ReadBracketedConstants() : ReadCharOrEscape();
+        std::string constants;
+        const std::string* sequence;
+
+        if (m_buffer[m_pos] == '{')
+        {
+            constants = ReadBracketedConstants();
+            sequence = &constants;
+        }
+        else
+        {
+            sequence = &ReadCharOrEscape();
+        }
 
-        for (const char& c : sequence)
+        for (const char& c : *sequence)
         {
             if (destLength == kMaxStringLength)
                 RaiseError("mapped string longer than %d bytes", kMaxStringLength);
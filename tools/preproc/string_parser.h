@@ -45,7 +45,7 @@ private:
     Integer ReadInteger();
     Integer ReadDecimal();
     Integer ReadHex();
-    std::string ReadCharOrEscape();
+    const std::string& ReadCharOrEscape();
     std::string ReadBracketedConstants();
     void SkipWhitespace();
     void SkipRestOfInteger(int radix);
@@ -20,13 +20,22 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <iostream>
 #include <tuple>
 #include <fstream>
+#include <sys/stat.h>
 #include "scaninc.h"
 #include "source_file.h"
 
@@ -41,30 +50,279 @@ bool CanOpenFile(std::string path)
     return true;
 }
 
-const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH] [-M DEPENDENCY_OUT_PATH] FILE_PATH\n";
+// The parts of a SourceFile that dependency scanning needs.
+struct ScannedFile
+{
+    std::set<std::string> incbins;
+    std::set<std::string> includes;
+    std::string srcDir;
+    SourceFileType fileType;
+};
 
-int main(int argc, char **argv)
+// Shares parsed files and include lookups between every source scanned by
+// this process, so that headers like global.h are only read once.
+class ScanCache
+{
+public:
+    ScanCache(const std::vector<std::string>& includeDirs) : m_includeDirs(includeDirs) {}
+
+    std::shared_ptr<const ScannedFile> GetFile(const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_files.find(path);
+            if (it != m_files.end())
+                return it->second;
+        }
+
+        // Parse outside the lock; two threads racing on one file both get a
+        // valid result, and the first one inserted wins.
+        SourceFile file(path);
+        auto scanned = std::make_shared<ScannedFile>();
+        scanned->incbins = file.GetIncbins();
+        scanned->includes = file.GetIncludes();
+        scanned->srcDir = file.GetSrcDir();
+        scanned->fileType = file.FileType();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_files.emplace(path, scanned).first->second;
+    }
+
+    // Returns the path an include resolves to from a file in srcDir, or an
+    // empty string if it does not exist.
+    std::string ResolveInclude(const ScannedFile& file, const std::string& include)
+    {
+        bool isAsm = file.fileType == SourceFileType::Asm || file.fileType == SourceFileType::Inc;
+        std::string key = (isAsm ? "A" : "C") + file.srcDir + '\n' + include;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_resolved.find(key);
+            if (it != m_resolved.end())
+                return it->second;
+        }
+
+        // The including file's own directory is searched last.
+        std::string resolved("");
+        std::string path;
+        for (size_t i = 0; i <= m_includeDirs.size() && resolved.empty(); i++)
+        {
+            path = (i < m_includeDirs.size() ? m_includeDirs[i] : file.srcDir) + include;
+            if (CanOpenFile(path))
+                resolved = path;
+        }
+        if (resolved.empty() && isAsm && CanOpenFile(include))
+            resolved = include;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resolved.emplace(key, resolved);
+        return resolved;
+    }
+
+private:
+    std::vector<std::string> m_includeDirs;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const ScannedFile>> m_files;
+    std::unordered_map<std::string, std::string> m_resolved;
+};
+
+void ScanDependencies(ScanCache& cache, const std::string& initialPath,
+                      std::set<std::string>& dependencies, std::set<std::string>& dependencies_includes)
 {
     std::queue<std::string> filesToProcess;
-    std::set<std::string> dependencies;
-    std::set<std::string> dependencies_includes;
 
+    filesToProcess.push(initialPath);
+
+    while (!filesToProcess.empty())
+    {
+        std::shared_ptr<const ScannedFile> file = cache.GetFile(filesToProcess.front());
+        filesToProcess.pop();
+
+        for (auto incbin : file->incbins)
+        {
+            dependencies.insert(incbin);
+        }
+        for (auto include : file->includes)
+        {
+            std::string path = cache.ResolveInclude(*file, include);
+            if (path.empty())
+                continue;
+
+            dependencies_includes.insert(path);
+            bool inserted = dependencies.insert(path).second;
+            if (inserted)
+            {
+                filesToProcess.push(path);
+            }
+        }
+    }
+}
+
+void WriteMakeRules(const std::string& make_outfile, const std::set<std::string>& dependencies,
+                    const std::set<std::string>& dependencies_includes)
+{
+    // Write out make rules to a file
+    std::ofstream output(make_outfile);
+
+    if (!output.is_open())
+        FATAL_ERROR("Failed to open \"%s\" for writing.\n", make_outfile.c_str());
+
+    // Print a make rule for the object file
+    size_t ext_pos = make_outfile.find_last_of(".");
+    auto object_file = make_outfile.substr(0, ext_pos + 1) + "o";
+    output << object_file.c_str() << ":";
+    for (const std::string &path : dependencies)
+    {
+        output << " " << path;
+    }
+    output << '\n';
+
+    // Dependency list rule.
+    // Although these rules are identical, they need to be separate, else make will trigger the rule again after the file is created for the first time.
+    output << make_outfile.c_str() << ":";
+    for (const std::string &path : dependencies_includes)
+    {
+        output << " " << path;
+    }
+    output << '\n';
+
+    // Dummy rules
+    // If a dependency is deleted, make will try to make it, instead of rescanning the dependencies before trying to do that.
+    for (const std::string &path : dependencies)
+    {
+        output << path << ":\n";
+    }
+
+    output.flush();
+    output.close();
+}
+
+bool GetModificationTime(const std::string& path, struct stat& st)
+{
+    return stat(path.c_str(), &st) == 0;
+}
+
+bool IsNewer(const struct stat& a, const struct stat& b)
+{
+#ifdef __APPLE__
+    return std::tie(a.st_mtimespec.tv_sec, a.st_mtimespec.tv_nsec) > std::tie(b.st_mtimespec.tv_sec, b.st_mtimespec.tv_nsec);
+#elif defined(_WIN32)
+    return a.st_mtime > b.st_mtime;
+#else
+    return std::tie(a.st_mtim.tv_sec, a.st_mtim.tv_nsec) > std::tie(b.st_mtim.tv_sec, b.st_mtim.tv_nsec);
+#endif
+}
+
+// Mirrors make's own check of the dependency list rule written by
+// WriteMakeRules: the rules are current if they are newer than the source
+// and every include they list.
+bool MakeRulesUpToDate(const std::string& make_outfile, const std::string& sourcePath)
+{
+    struct stat outStat, depStat;
+
+    if (!GetModificationTime(make_outfile, outStat))
+        return false;
+    if (!GetModificationTime(sourcePath, depStat) || IsNewer(depStat, outStat))
+        return false;
+
+    std::ifstream input(make_outfile);
+    std::string line;
+    std::string target = make_outfile + ":";
+
+    while (std::getline(input, line))
+    {
+        if (line.compare(0, target.size(), target) != 0)
+            continue;
+
+        size_t pos = target.size();
+        while (pos < line.size())
+        {
+            size_t end = line.find(' ', pos + 1);
+            if (end == std::string::npos)
+                end = line.size();
+            std::string path = line.substr(pos + 1, end - pos - 1);
+            if (!path.empty() && (!GetModificationTime(path, depStat) || IsNewer(depStat, outStat)))
+                return false;
+            pos = end;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// Writes the make rules for every "DEPENDENCY_OUT_PATH FILE_PATH" pair in
+// listPath, skipping those that are already up to date.
+void ScanBatch(const std::vector<std::string>& includeDirs, const std::string& listPath, unsigned int numThreads)
+{
+    std::ifstream list(listPath);
+    std::vector<std::pair<std::string, std::string>> jobs;
+    std::string make_outfile, sourcePath;
+
+    if (!list.is_open())
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", listPath.c_str());
+
+    while (list >> make_outfile >> sourcePath)
+        jobs.emplace_back(make_outfile, sourcePath);
+
+    if (!list.eof())
+        FATAL_ERROR("Odd number of paths in \"%s\".\n", listPath.c_str());
+
+    ScanCache cache(includeDirs);
+    std::atomic<size_t> nextJob(0);
+    auto worker = [&]()
+    {
+        size_t i;
+        while ((i = nextJob++) < jobs.size())
+        {
+            if (MakeRulesUpToDate(jobs[i].first, jobs[i].second))
+                continue;
+
+            std::set<std::string> dependencies;
+            std::set<std::string> dependencies_includes;
+            ScanDependencies(cache, jobs[i].second, dependencies, dependencies_includes);
+            WriteMakeRules(jobs[i].first, dependencies, dependencies_includes);
+        }
+    };
+
+    if (numThreads == 0)
+        numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH] [-M DEPENDENCY_OUT_PATH] FILE_PATH\n"
+                          "       scaninc [-I INCLUDE_PATH] [-j THREADS] -b LIST_PATH\n";
+
+int main(int argc, char **argv)
+{
     std::vector<std::string> includeDirs;
 
     bool makeformat = false;
     std::string make_outfile;
+    std::string listPath;
+    unsigned int numThreads = 0;
 
     argc--;
     argv++;
 
-    while (argc > 1)
+    while (argc > 0 && argv[0][0] == '-')
     {
         std::string arg(argv[0]);
         if (arg.substr(0, 2) == "-I")
         {
             std::string includeDir = arg.substr(2);
-            if (includeDir.empty())
+            if (arg.size() == 2)
             {
+                if (argc < 2)
+                    FATAL_ERROR(USAGE);
                 argc--;
                 argv++;
                 includeDir = std::string(argv[0]);
@@ -75,12 +333,25 @@ int main(int argc, char **argv)
             }
             includeDirs.push_back(includeDir);
         }
-        else if(arg.substr(0, 2) == "-M")
+        else if (arg == "-M" || arg == "-b" || arg == "-j")
         {
-            makeformat = true;
+            if (argc < 2)
+                FATAL_ERROR(USAGE);
             argc--;
             argv++;
-            make_outfile = std::string(argv[0]);
+            if (arg == "-M")
+            {
+                makeformat = true;
+                make_outfile = std::string(argv[0]);
+            }
+            else if (arg == "-b")
+            {
+                listPath = std::string(argv[0]);
+            }
+            else
+            {
+                numThreads = std::strtoul(argv[0], NULL, 10);
+            }
         }
         else
         {
@@ -90,56 +361,24 @@ int main(int argc, char **argv)
         argv++;
     }
 
+    if (!listPath.empty())
+    {
+        if (argc != 0 || makeformat)
+            FATAL_ERROR(USAGE);
+        ScanBatch(includeDirs, listPath, numThreads);
+        return 0;
+    }
+
     if (argc != 1) {
         FATAL_ERROR(USAGE);
     }
 
     std::string initialPath(argv[0]);
+    std::set<std::string> dependencies;
+    std::set<std::string> dependencies_includes;
+    ScanCache cache(includeDirs);
 
-    filesToProcess.push(initialPath);
-
-    while (!filesToProcess.empty())
-    {
-        std::string filePath = filesToProcess.front();
-        SourceFile file(filePath);
-        filesToProcess.pop();
-
-        includeDirs.push_back(file.GetSrcDir());
-        for (auto incbin : file.GetIncbins())
-        {
-            dependencies.insert(incbin);
-        }
-        for (auto include : file.GetIncludes())
-        {
-            bool exists = false;
-            std::string path("");
-            for (auto includeDir : includeDirs)
-            {
-                path = includeDir + include;
-                if (CanOpenFile(path))
-                {
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists && (file.FileType() == SourceFileType::Asm || file.FileType() == SourceFileType::Inc))
-            {
-                path = include;
-                if (CanOpenFile(path))
-                    exists = true;
-            }
-            if (!exists)
-                continue;
-
-            dependencies_includes.insert(path);
-            bool inserted = dependencies.insert(path).second;
-            if (inserted && exists)
-            {
-                filesToProcess.push(path);
-            }
-        }
-        includeDirs.pop_back();
-    }
+    ScanDependencies(cache, initialPath, dependencies, dependencies_includes);
 
     if(!makeformat)
     {
@@ -151,36 +390,6 @@ int main(int argc, char **argv)
     }
     else
     {
-        // Write out make rules to a file
-        std::ofstream output(make_outfile);
-
-        // Print a make rule for the object file
-        size_t ext_pos = make_outfile.find_last_of(".");
-        auto object_file = make_outfile.substr(0, ext_pos + 1) + "o";
-        output << object_file.c_str() << ":";
-        for (const std::string &path : dependencies)
-        {
-            output << " " << path;
-        }
-        output << '\n';
-
-        // Dependency list rule.
-        // Although these rules are identical, they need to be separate, else make will trigger the rule again after the file is created for the first time.
-        output << make_outfile.c_str() << ":";
-        for (const std::string &path : dependencies_includes)
-        {
-            output << " " << path;
-        }
-        output << '\n';
-
-        // Dummy rules
-        // If a dependency is deleted, make will try to make it, instead of rescanning the dependencies before trying to do that.
-        for (const std::string &path : dependencies)
-        {
-            output << path << ":\n";
-        }
-
-        output.flush();
-        output.close();
+        WriteMakeRules(make_outfile, dependencies, dependencies_includes);
     }
 }
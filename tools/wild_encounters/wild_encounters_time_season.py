@@ -218,13 +218,70 @@ class WildEncounterAssembler:
         self.WriteTerminator()
         self.WriteLine("};")
 
-                
+
+    # Lookup tables so the runtime doesn't have to walk the headers:
+    # (mapGroup, mapNum) -> first header id of the map, and species -> set of headers it can appear in.
+    # Header ids differ between versions, so they're written once per version.
+    def WriteHeaderIndexes(self, headers):
+        map_layout = LoadMapLayout()
+        for version in ["FIRERED", "LEAFGREEN"]:
+            labels = [label for label in headers["data"] if GetVersion(label) == version]
+            header_ids = {}
+            species_headers = {}
+            for header_id, label in enumerate(labels):
+                header_ids.setdefault(headers["maps"][label], header_id)
+                for species in headers["species"][label]:
+                    species_headers.setdefault(species, set()).add(header_id)
+
+            set_words = max(1, (len(labels) + 31) // 32)
+            self.WriteLine(f"#ifdef {version}")
+            self.WriteLine(f"static const u16 sWildMonHeaderMapOffsets[] =")
+            self.WriteLine("{")
+            offset = 0
+            for group in map_layout:
+                self.WriteLine(f"{offset},", 1)
+                offset += len(group)
+            self.WriteLine(f"{offset},", 1)
+            self.WriteLine("};")
+            self.WriteLine()
+            self.WriteLine(f"static const u16 sWildMonHeaderIdsByMap[] =")
+            self.WriteLine("{")
+            for group in map_layout:
+                for map_id in group:
+                    if map_id in header_ids:
+                        self.WriteLine(f"{header_ids[map_id]}, // {map_id}", 1)
+                    else:
+                        self.WriteLine(f"HEADER_NONE, // {map_id}", 1)
+            self.WriteLine("};")
+            self.WriteLine()
+            self.WriteLine(f"#define WILD_MON_HEADER_SET_WORDS {set_words}")
+            self.WriteLine()
+            self.WriteLine(f"static const u16 sWildSpeciesHeaderSetIds[NUM_SPECIES] =")
+            self.WriteLine("{")
+            for set_id, species in enumerate(species_headers, 1):
+                self.WriteLine(f"[{species}] = {set_id},", 1)
+            self.WriteLine("};")
+            self.WriteLine()
+            self.WriteLine(f"static const u32 sWildSpeciesHeaderSets[][WILD_MON_HEADER_SET_WORDS] =")
+            self.WriteLine("{")
+            self.WriteLine("{0},", 1)
+            for species, header_set in species_headers.items():
+                words = [0] * set_words
+                for header_id in header_set:
+                    words[header_id // 32] |= 1 << (header_id % 32)
+                self.WriteLine("{" + ", ".join(f"0x{word:X}" for word in words) + f"}}, // {species}", 1)
+            self.WriteLine("};")
+            self.WriteLine(f"#endif")
+            self.WriteLine()
+
     def WriteEncounters(self):
         wild_encounter_groups = self.json_data["wild_encounter_groups"]
         for wild_encounter_group in wild_encounter_groups:
             headers = {}
             headers["label"] = wild_encounter_group["label"]
             headers["data"] = {}
+            headers["species"] = {}
+            headers["maps"] = {}
             for_maps = False
             map_num_counter = 1
             if "for_maps" in wild_encounter_group:
@@ -255,6 +312,8 @@ class WildEncounterAssembler:
 
                 if shared_label not in headers["data"]:
                     headers["data"][shared_label] = {}
+                    headers["species"][shared_label] = set()
+                    headers["maps"][shared_label] = map_name
                 if season not in headers["data"][shared_label]:
                     headers["data"][shared_label][season] = {}
                 if time not in headers["data"][shared_label][season]:
@@ -274,6 +333,7 @@ class WildEncounterAssembler:
                     mons_entry = map_encounters[mon_type]
                     encounter_rate = mons_entry["encounter_rate"]
                     mons = mons_entry["mons"]
+                    headers["species"][shared_label].update(mon["species"] for mon in mons)
 
                     mon_array_name = base_label + "_" + mon_type.title().replace("_", "")
                     self.WriteMonInfos(mon_array_name, mons, encounter_rate)
@@ -281,7 +341,27 @@ class WildEncounterAssembler:
                 self.WriteLine(f"#endif")
 
             self.WritePokemonHeaders(headers)
-
+            if for_maps and headers["label"] == "gWildMonHeaders":
+                self.WriteHeaderIndexes(headers)
+
+
+def GetVersion(shared_label):
+    if "LeafGreen" in shared_label:
+        return "LEAFGREEN"
+    return "FIRERED"
+
+# Returns the map ids of every map group, in the order mapjson numbers them.
+def LoadMapLayout():
+    with open('data/maps/map_groups.json', 'r') as map_groups_file:
+        map_groups = json.load(map_groups_file)
+    layout = []
+    for group_name in map_groups["group_order"]:
+        group = []
+        for map_name in map_groups[group_name]:
+            with open(f'data/maps/{map_name}/map.json', 'r') as map_file:
+                group.append(json.load(map_file)["id"])
+        layout.append(group)
+    return layout
 
 def ConvertToHeaderFile(json_data):
     with open('src/data/wild_encounters.h', 'w') as output_file: